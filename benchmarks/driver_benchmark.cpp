@@ -0,0 +1,111 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "minas/minas_driver.hpp"
+#include "zeroerr/zeroerr_driver.hpp"
+
+namespace {
+
+constexpr uint8_t AXES = 16;
+
+/** Statusword the drive reports on each cycle of the enable walk: Fault → … → OperationEnabled. */
+constexpr uint16_t ENABLE_STATUSWORDS[] = {0x0008, 0x0040, 0x0021, 0x0023, 0x0027};
+
+motor_interface::driver_config_t driverConfig()
+{
+    motor_interface::driver_config_t cfg{};
+    cfg.pulse_per_revolution = 8388608;
+    cfg.rated_torque = 1.27;
+    cfg.unit_torque = 1.0;
+    return cfg;
+}
+
+/** Counts → SI → counts for position, velocity and torque of `AXES` axes through the virtual interface. */
+template <typename Driver>
+void BM_DriverConversion(benchmark::State& state)
+{
+    Driver concrete(driverConfig());
+    motor_interface::MotorDriver& driver = concrete;
+    int32_t counts[AXES];
+    for (uint8_t i = 0; i < AXES; ++i) counts[i] = 1000 * i - 5000;
+
+    for (auto _ : state) {
+        for (uint8_t i = 0; i < AXES; ++i) {
+            const double position = driver.position(counts[i]);
+            const double velocity = driver.velocity(counts[i]);
+            const double torque = driver.torque(static_cast<int16_t>(counts[i]));
+            counts[i] = driver.position(position) + driver.velocity(velocity) - driver.torque(torque);
+        }
+        benchmark::DoNotOptimize(counts);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * AXES));
+}
+BENCHMARK_TEMPLATE(BM_DriverConversion, minas::MinasDriver);
+BENCHMARK_TEMPLATE(BM_DriverConversion, zeroerr::ZeroerrDriver);
+
+/** Full CiA402 enable walk from Fault, one `isEnabled()` per cycle until it reports enabled. */
+template <typename Driver>
+void BM_DriverEnable(benchmark::State& state)
+{
+    Driver concrete(driverConfig());
+    motor_interface::MotorDriver& driver = concrete;
+
+    for (auto _ : state) {
+        motor_interface::cia402_axis_t axis{};
+        uint8_t out[2]{};
+        for (uint16_t sw : ENABLE_STATUSWORDS) {
+            uint8_t data[2];
+            motor_interface::fill<uint16_t>(sw, data);
+            if (driver.isEnabled(data, axis, out)) break;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK_TEMPLATE(BM_DriverEnable, minas::MinasDriver);
+BENCHMARK_TEMPLATE(BM_DriverEnable, zeroerr::ZeroerrDriver);
+
+/** `isDisabled()` from OperationEnabled until the drive reports switch-on disabled. */
+template <typename Driver>
+void BM_DriverDisable(benchmark::State& state)
+{
+    Driver concrete(driverConfig());
+    motor_interface::MotorDriver& driver = concrete;
+
+    for (auto _ : state) {
+        motor_interface::cia402_axis_t axis{};
+        uint8_t out[2]{};
+        for (uint16_t sw : {uint16_t{0x0027}, uint16_t{0x0040}}) {
+            uint8_t data[2];
+            motor_interface::fill<uint16_t>(sw, data);
+            if (driver.isDisabled(data, axis, out)) break;
+        }
+        benchmark::DoNotOptimize(out);
+    }
+}
+BENCHMARK_TEMPLATE(BM_DriverDisable, minas::MinasDriver);
+BENCHMARK_TEMPLATE(BM_DriverDisable, zeroerr::ZeroerrDriver);
+
+/** One engine pass over `AXES` axes spread across every CiA402 state, as `MotorManager` steps them during bring-up. */
+void BM_Cia402Pass(benchmark::State& state)
+{
+    constexpr uint16_t statuswords[] = {0x0008, 0x0040, 0x0021, 0x0023, 0x0027, 0x0007, 0x000F, 0x0000};
+    motor_interface::cia402_axis_t axes[AXES]{};
+    uint16_t controlwords[AXES]{};
+    uint32_t cycle{0};
+
+    for (auto _ : state) {
+        uint8_t reached{0};
+        cycle++;
+        for (uint8_t i = 0; i < AXES; ++i) {
+            const uint16_t sw = statuswords[(i + cycle) % 8];
+            reached += motor_interface::step(minas::MINAS_CIA402, motor_interface::Cia402Goal::Enable, sw, axes[i], controlwords[i]);
+        }
+        benchmark::DoNotOptimize(reached);
+        benchmark::DoNotOptimize(controlwords);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * AXES));
+}
+BENCHMARK(BM_Cia402Pass);
+
+} // namespace
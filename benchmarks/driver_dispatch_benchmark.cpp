@@ -0,0 +1,111 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "motor_manager/driver_dispatch.hpp"
+
+namespace {
+
+constexpr uint8_t AXES = 16;
+
+motor_interface::driver_config_t driverConfig(uint8_t id)
+{
+    motor_interface::driver_config_t cfg{};
+    cfg.id = id;
+    cfg.pulse_per_revolution = 8388608;
+    cfg.rated_torque = 1.27;
+    cfg.unit_torque = 1.0;
+    return cfg;
+}
+
+/** Half MINAS, half ZeroErr, as on a mixed machine. */
+struct axes_t {
+    std::vector<std::unique_ptr<motor_interface::MotorDriver>> drivers;
+    std::vector<motor_manager::driver_handle_t> handles;
+    uint16_t statusword[AXES];
+
+    axes_t()
+    {
+        for (uint8_t i = 0; i < AXES; ++i) {
+            if (i % 2) drivers.push_back(std::make_unique<zeroerr::ZeroerrDriver>(driverConfig(i)));
+            else drivers.push_back(std::make_unique<minas::MinasDriver>(driverConfig(i)));
+            handles.push_back(motor_manager::toDriverHandle(drivers.back().get()));
+            statusword[i] = (i % 3) ? 0x1027 : 0x0027;
+        }
+    }
+};
+
+void BM_ReceivedVirtual(benchmark::State& state)
+{
+    axes_t axes;
+    for (auto _ : state) {
+        for (uint8_t i = 0; i < AXES; ++i) {
+            uint8_t sw_data[2];
+            uint8_t cw_data[2]{0};
+            motor_interface::fill<uint16_t>(axes.statusword[i], sw_data);
+            benchmark::DoNotOptimize(axes.drivers[i]->isReceived(sw_data, cw_data));
+            benchmark::DoNotOptimize(cw_data);
+        }
+    }
+}
+BENCHMARK(BM_ReceivedVirtual);
+
+void BM_ReceivedStatic(benchmark::State& state)
+{
+    axes_t axes;
+    for (auto _ : state) {
+        for (uint8_t i = 0; i < AXES; ++i) {
+            uint16_t cw{0};
+            benchmark::DoNotOptimize(motor_manager::received(axes.handles[i], axes.statusword[i], cw));
+            benchmark::DoNotOptimize(cw);
+        }
+    }
+}
+BENCHMARK(BM_ReceivedStatic);
+
+void BM_ConversionVirtual(benchmark::State& state)
+{
+    axes_t axes;
+    int32_t counts[AXES];
+    double si[AXES * 3];
+    for (uint8_t i = 0; i < AXES; ++i) counts[i] = 1000 * i;
+
+    for (auto _ : state) {
+        for (uint8_t i = 0; i < AXES; ++i) {
+            si[i * 3] = axes.drivers[i]->position(counts[i]);
+            si[i * 3 + 1] = axes.drivers[i]->velocity(counts[i]);
+            si[i * 3 + 2] = axes.drivers[i]->torque(static_cast<int16_t>(counts[i]));
+        }
+        for (uint8_t i = 0; i < AXES; ++i) {
+            counts[i] = axes.drivers[i]->position(si[i * 3]);
+            counts[i] += axes.drivers[i]->velocity(si[i * 3 + 1]);
+            counts[i] += axes.drivers[i]->torque(si[i * 3 + 2]);
+        }
+        benchmark::DoNotOptimize(counts);
+    }
+}
+BENCHMARK(BM_ConversionVirtual);
+
+void BM_ConversionBatched(benchmark::State& state)
+{
+    axes_t axes;
+    motor_interface::UnitConverter converter;
+    motor_interface::axis_lanes_t lanes;
+    converter.resize(AXES);
+    lanes.resize(AXES);
+    for (uint8_t i = 0; i < AXES; ++i) {
+        converter.configure(i, axes.drivers[i]->scale());
+        lanes.position_count[i] = lanes.velocity_count[i] = lanes.torque_count[i] = 1000 * i;
+    }
+
+    for (auto _ : state) {
+        converter.toSI(lanes, AXES);
+        converter.toCounts(lanes, AXES);
+        benchmark::DoNotOptimize(lanes.position_count.data());
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ConversionBatched);
+
+} // namespace
@@ -0,0 +1,179 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "motor_manager/motor_manager.hpp"
+
+namespace {
+
+constexpr char MINAS_PARAMETERS[] =
+    "items:\n"
+    "  - {id: 50, index: 0x6072, subindex: 0, type: u16}\n"
+    "  - {id: 10, index: 0x6060, subindex: 0, type: s8, value: 8}\n"
+    "interfaces:\n"
+    "  - {id: 98, index: 0x1600}\n"
+    "  - {id: 0, index: 0x6040, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 1, index: 0x607A, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 2, index: 0x60FF, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 3, index: 0x6071, subindex: 0, size: 2, type: s16}\n"
+    "  - {id: 99, index: 0x1A00}\n"
+    "  - {id: 4, index: 0x6041, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 5, index: 0x603F, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 6, index: 0x6064, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 7, index: 0x606C, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 8, index: 0x6077, subindex: 0, size: 2, type: s16}\n";
+
+/** Cycles stepped before measuring, enough for every simulated axis to reach OperationEnabled. */
+constexpr int WARMUP_CYCLES = 200;
+
+/** Writes a simulation configuration of `axes` MINAS axes spread over `masters` masters into the temp directory; returns its path. */
+std::string writeConfiguration(uint16_t axes, uint8_t masters)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "motor_manager_benchmarks";
+    std::filesystem::create_directories(directory);
+
+    std::ofstream(directory / "minas.yaml") << MINAS_PARAMETERS;
+
+    const std::filesystem::path config =
+        directory / ("axes_" + std::to_string(axes) + "_" + std::to_string(masters) + ".yaml");
+    std::ofstream out(config);
+    out << "period: 1000000\nmasters:\n";
+    uint16_t index{0};
+    for (uint8_t m = 0; m < masters; ++m) {
+        const uint16_t slaves = static_cast<uint16_t>(axes / masters + (m < axes % masters ? 1 : 0));
+        out << "  - id: " << static_cast<int>(m) << "\n"
+               "    type: simulation\n"
+               "    number_of_slaves: " << slaves << "\n"
+               "    time_constant: 0.005\n"
+               "    slaves:\n";
+        for (uint16_t i = 0; i < slaves; ++i, ++index) {
+            out << "      - {controller_index: " << index << ", driver_id: 0}\n";
+        }
+    }
+    out << "drivers:\n"
+           "  - {id: 0, type: minas, param_file: minas.yaml, pulse_per_revolution: 8388608, rated_torque: 1.27, "
+           "unit_torque: 1.0, lower: -3.14, upper: 3.14, speed: 3000, acceleration: 100, deceleration: 100, "
+           "profile_velocity: 1, profile_acceleration: 1, profile_deceleration: 1}\n";
+    return config.string();
+}
+
+/** A started manager with every axis enabled, stepped on a virtual clock. */
+struct manager_t {
+    std::unique_ptr<motor_manager::MotorManager> manager;
+    uint64_t time{0};
+
+    manager_t(uint16_t axes, uint8_t masters)
+    : manager(std::make_unique<motor_manager::MotorManager>(writeConfiguration(axes, masters)))
+    {
+        manager->start();
+        for (int k = 0; k < WARMUP_CYCLES; ++k) step();
+    }
+
+    ~manager_t() { manager->stop(); }
+
+    bool step() { return manager->step(time += manager->period()); }
+};
+
+/** Axis counts × masters of the scaling runs; the 48 × 3 case is the next machine. */
+void scaling(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgNames({"axes", "masters"});
+    for (const auto& args : std::vector<std::vector<int64_t>>{
+             {1, 1}, {8, 1}, {16, 1}, {48, 3}, {64, 1}, {256, 4}, {1024, 8}}) {
+        benchmark->Args(args);
+    }
+}
+
+/** Steady-state cycle without new commands: exchange, status decode, publish. */
+void BM_Step(benchmark::State& state)
+{
+    const uint16_t axes = static_cast<uint16_t>(state.range(0));
+    manager_t m(axes, static_cast<uint8_t>(state.range(1)));
+
+    for (auto _ : state) benchmark::DoNotOptimize(m.step());
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * axes));
+}
+BENCHMARK(BM_Step)->Apply(scaling);
+
+/** As `BM_Step` with a client `write()` of new target positions before every cycle. */
+void BM_StepCommand(benchmark::State& state)
+{
+    const uint16_t axes = static_cast<uint16_t>(state.range(0));
+    manager_t m(axes, static_cast<uint8_t>(state.range(1)));
+
+    std::vector<motor_interface::motor_frame_t> frames(axes);
+    for (uint16_t i = 0; i < axes; ++i) {
+        frames[i].controlword = 0x000F;
+        frames[i].number_of_target_interfaces = 2;
+        frames[i].target_interface_id[0] = motor_interface::ID_CONTROLWORD;
+        frames[i].target_interface_id[1] = motor_interface::ID_TARGET_POSITION;
+    }
+
+    double position{0.0};
+    for (auto _ : state) {
+        position = position > 1.0 ? 0.0 : position + 0.001;
+        for (uint16_t i = 0; i < axes; ++i) frames[i].position = position;
+        m.manager->write(frames.data(), axes);
+        benchmark::DoNotOptimize(m.step());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * axes));
+}
+BENCHMARK(BM_StepCommand)->Apply(scaling);
+
+/** As `BM_StepCommand`, but only one axis (round robin) gets a new target per cycle, through the sparse `write()`. */
+void BM_StepSparse(benchmark::State& state)
+{
+    const uint16_t axes = static_cast<uint16_t>(state.range(0));
+    manager_t m(axes, static_cast<uint8_t>(state.range(1)));
+
+    motor_manager::axis_command_t command{};
+    command.frame.controlword = 0x000F;
+    command.frame.number_of_target_interfaces = 2;
+    command.frame.target_interface_id[0] = motor_interface::ID_CONTROLWORD;
+    command.frame.target_interface_id[1] = motor_interface::ID_TARGET_POSITION;
+
+    double position{0.0};
+    for (auto _ : state) {
+        position = position > 1.0 ? 0.0 : position + 0.001;
+        command.index = static_cast<uint16_t>((command.index + 1) % axes);
+        command.frame.position = position;
+        m.manager->write(&command, 1);
+        benchmark::DoNotOptimize(m.step());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * axes));
+}
+BENCHMARK(BM_StepSparse)->Apply(scaling);
+
+/** As `BM_StepCommand`, with the commands posted and the status read back through a `SharedMemoryClient`. */
+void BM_StepShared(benchmark::State& state)
+{
+    const uint16_t axes = static_cast<uint16_t>(state.range(0));
+    manager_t m(axes, static_cast<uint8_t>(state.range(1)));
+    m.manager->open_shared_memory("/motor_manager_benchmarks");
+    motor_manager::SharedMemoryClient client;
+    client.open("/motor_manager_benchmarks");
+
+    motor_interface::motor_frame_t frame{};
+    frame.controlword = 0x000F;
+    frame.number_of_target_interfaces = 2;
+    frame.target_interface_id[0] = motor_interface::ID_CONTROLWORD;
+    frame.target_interface_id[1] = motor_interface::ID_TARGET_POSITION;
+    std::vector<motor_interface::motor_frame_t> status(axes);
+
+    for (auto _ : state) {
+        frame.position = frame.position > 1.0 ? 0.0 : frame.position + 0.001;
+        for (uint16_t i = 0; i < axes; ++i) client.write(i, frame);
+        benchmark::DoNotOptimize(m.step());
+        benchmark::DoNotOptimize(client.read(status.data()));
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * axes));
+    client.close();
+    m.manager->close_shared_memory();
+}
+BENCHMARK(BM_StepShared)->Apply(scaling);
+
+} // namespace
@@ -0,0 +1,94 @@
+#include <cstdint>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "motor_interface/pdo_plan.hpp"
+
+namespace {
+
+/** One slave's CSP mapping as in the MINAS / ZeroErr parameter files. */
+struct mapped_entry_t {
+    uint8_t id;
+    motor_interface::DataType type;
+    uint8_t size;
+};
+
+constexpr mapped_entry_t RX_ENTRIES[] = {
+    {motor_interface::ID_CONTROLWORD, motor_interface::DataType::U16, 2},
+    {motor_interface::ID_TARGET_POSITION, motor_interface::DataType::S32, 4},
+    {motor_interface::ID_TARGET_VELOCITY, motor_interface::DataType::S32, 4},
+    {motor_interface::ID_TARGET_TORQUE, motor_interface::DataType::S16, 2},
+};
+
+constexpr mapped_entry_t TX_ENTRIES[] = {
+    {motor_interface::ID_STATUSWORD, motor_interface::DataType::U16, 2},
+    {motor_interface::ID_ERRORCODE, motor_interface::DataType::U16, 2},
+    {motor_interface::ID_CURRENT_POSITION, motor_interface::DataType::S32, 4},
+    {motor_interface::ID_CURRENT_VELOCITY, motor_interface::DataType::S32, 4},
+    {motor_interface::ID_CURRENT_TORQUE, motor_interface::DataType::S16, 2},
+};
+
+/**
+ * Fake domain: slaves back to back in one buffer, each with an RX and a TX plan, as `EthercatController` builds them
+ * in `registerEntries()`. `readData()` / `writeData()` are a `load()` / `store()` per slave and domain.
+ */
+struct domain_t {
+    std::vector<uint8_t> pd;
+    std::vector<motor_interface::PdoPlan> rx;
+    std::vector<motor_interface::PdoPlan> tx;
+
+    explicit domain_t(std::size_t slaves)
+    : rx(slaves)
+    , tx(slaves)
+    {
+        uint32_t offset{0};
+        for (std::size_t s = 0; s < slaves; ++s) {
+            for (const auto& e : RX_ENTRIES) {
+                rx[s].add(e.id, offset, e.type);
+                offset += e.size;
+            }
+            for (const auto& e : TX_ENTRIES) {
+                tx[s].add(e.id, offset, e.type);
+                offset += e.size;
+            }
+        }
+        pd.resize(offset);
+        for (std::size_t i = 0; i < pd.size(); ++i) pd[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+};
+
+void BM_PdoLoad(benchmark::State& state)
+{
+    const std::size_t slaves = static_cast<std::size_t>(state.range(0));
+    domain_t domain(slaves);
+    int32_t values[motor_interface::NUMBER_OF_INTERFACE_IDS]{};
+
+    for (auto _ : state) {
+        for (std::size_t s = 0; s < slaves; ++s) {
+            domain.tx[s].load(domain.pd.data(), values);
+            benchmark::DoNotOptimize(values);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * slaves));
+}
+BENCHMARK(BM_PdoLoad)->Arg(1)->Arg(8)->Arg(16);
+
+void BM_PdoStore(benchmark::State& state)
+{
+    const std::size_t slaves = static_cast<std::size_t>(state.range(0));
+    domain_t domain(slaves);
+    int32_t values[motor_interface::NUMBER_OF_INTERFACE_IDS]{0x1F, 123456, -7890, -300};
+
+    for (auto _ : state) {
+        for (std::size_t s = 0; s < slaves; ++s) {
+            domain.rx[s].store(domain.pd.data(), values, domain.rx[s].mask());
+        }
+        benchmark::DoNotOptimize(domain.pd.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * slaves));
+}
+BENCHMARK(BM_PdoStore)->Arg(1)->Arg(8)->Arg(16);
+
+} // namespace
@@ -0,0 +1,49 @@
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "motor_interface/motor_driver.hpp"
+
+namespace {
+
+/** Entries per iteration: about one slave's worth of process data for each width. */
+constexpr std::size_t ENTRIES = 64;
+
+template <typename T>
+void BM_Value(benchmark::State& state)
+{
+    uint8_t buffer[ENTRIES * sizeof(T)];
+    for (std::size_t i = 0; i < sizeof(buffer); ++i) buffer[i] = static_cast<uint8_t>(i * 37 + 11);
+
+    for (auto _ : state) {
+        int64_t sum{0};
+        for (std::size_t i = 0; i < ENTRIES; ++i) sum += static_cast<int64_t>(motor_interface::value<T>(buffer + i * sizeof(T)));
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ENTRIES));
+}
+BENCHMARK_TEMPLATE(BM_Value, uint16_t);
+BENCHMARK_TEMPLATE(BM_Value, int16_t);
+BENCHMARK_TEMPLATE(BM_Value, int32_t);
+BENCHMARK_TEMPLATE(BM_Value, uint64_t);
+
+template <typename T>
+void BM_Fill(benchmark::State& state)
+{
+    uint8_t buffer[ENTRIES * sizeof(T)];
+    T values[ENTRIES];
+    for (std::size_t i = 0; i < ENTRIES; ++i) values[i] = static_cast<T>(i * 2654435761u);
+
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < ENTRIES; ++i) motor_interface::fill<T>(values[i], buffer + i * sizeof(T));
+        benchmark::DoNotOptimize(buffer);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * ENTRIES));
+}
+BENCHMARK_TEMPLATE(BM_Fill, uint16_t);
+BENCHMARK_TEMPLATE(BM_Fill, int16_t);
+BENCHMARK_TEMPLATE(BM_Fill, int32_t);
+BENCHMARK_TEMPLATE(BM_Fill, uint64_t);
+
+} // namespace
@@ -16,6 +16,9 @@ inline constexpr uint8_t ID_CURRENT_POSITION = 6;
 inline constexpr uint8_t ID_CURRENT_VELOCITY = 7;
 inline constexpr uint8_t ID_CURRENT_TORQUE   = 8;
 
+/** Timeout of the runtime SDO requests in ms. */
+inline constexpr uint32_t SDO_TIMEOUT = 1000;
+
 class EthercatController : public motor_interface::MotorController {
 public:
     explicit EthercatController(const motor_interface::slave_config_t& config)
@@ -41,22 +44,39 @@ public:
 
     void read(motor_interface::motor_frame_t& status) override;
 
+    bool startSdo(const motor_interface::sdo_request_t& request) override;
+
+    motor_interface::SdoState pollSdo(uint32_t& value) override;
+
 private:
-    void writeData(const motor_interface::entry_table_t* rx_interfaces, uint8_t number_of_rx_interfaces) override;
+    void writeData(const int32_t* values, uint16_t mask) override;
 
-    void readData(motor_interface::entry_table_t* tx_interfaces, uint8_t number_of_tx_interfaces) override;
+    void readData(int32_t* values) override;
 
     void addSlaveConfigSdos();
 
     void addSlaveConfigPdos();
 
+    /** Pre-creates the runtime SDO requests; the master only accepts them before activation. */
+    void addSdoRequests();
+
     EthercatMaster* master_{nullptr};
 
     ec_slave_config_t* slave_config_{nullptr};
 
     unsigned int offset_[motor_interface::MAX_INTERFACE_SIZE];
 
-    motor_interface::entry_table_t tx_interfaces_[motor_interface::MAX_INTERFACE_SIZE];
+    /** Plans of domains `1 … number_of_domains_ - 1`, relative to their own `domain_pd(d)`; domain 0 uses `rx_plan_` / `tx_plan_`. */
+    motor_interface::PdoPlan rx_plans_[motor_interface::MAX_DOMAIN_SIZE - 1];
+
+    motor_interface::PdoPlan tx_plans_[motor_interface::MAX_DOMAIN_SIZE - 1];
+
+    uint8_t number_of_domains_{1};
+
+    /** Runtime SDO requests of 1, 2 and 4 bytes: writes need the object's exact size, reads use the 4-byte one. */
+    ec_sdo_request_t* sdo_requests_[3]{};
+
+    ec_sdo_request_t* sdo_active_{nullptr};
 
     const uint16_t alias_;
 
@@ -7,6 +7,9 @@
 
 namespace ethercat {
 
+/** `receive()` polls `ecrt_master_state` (an ioctl) once every this many cycles; `ecrt_domain_state` runs every cycle. */
+inline constexpr uint32_t MASTER_STATE_INTERVAL = 100;
+
 class EthercatMaster : public motor_interface::MotorMaster {
 public:
     explicit EthercatMaster(const motor_interface::master_config_t& config)
@@ -21,30 +24,52 @@ public:
 
     virtual void deactivate() override;
 
-    virtual void transmit() override;
+    virtual int transmit() override;
 
-    virtual void receive() override;
+    virtual int receive() override;
 
     virtual void apply_application_time(const timespec& time) override;
 
     virtual void save_clock() override;
 
+    virtual bool reference_clock_time(uint32_t& time) override;
+
+    virtual motor_interface::DataState data_state() const override { return data_state_; }
+
+    virtual bool link_up() const override { return link_up_; }
+
+    /** Working counter of the last processed datagrams of `domain`. */
+    unsigned int working_counter(uint8_t domain = 0) const { return domain_states_[domain].working_counter; }
+
     ec_master_t* master() const { return master_; }
 
-    ec_domain_t* domain() const { return domain_; }
+    ec_domain_t* domain(uint8_t domain = 0) const { return domains_[domain]; }
 
-    uint8_t* domain_pd() const { return domain_pd_; }
+    uint8_t* domain_pd(uint8_t domain = 0) const { return domain_pds_[domain]; }
 
     unsigned int master_index() const { return master_index_; }
 
 private:
     ec_master_t* master_{nullptr};
 
-    ec_domain_t* domain_{nullptr};
+    ec_domain_t* domains_[motor_interface::MAX_DOMAIN_SIZE]{};
 
-    uint8_t* domain_pd_{nullptr};
+    uint8_t* domain_pds_[motor_interface::MAX_DOMAIN_SIZE]{};
 
     const unsigned int master_index_{0};
+
+    ec_domain_state_t domain_states_[motor_interface::MAX_DOMAIN_SIZE]{};
+
+    /** Domains queued by the last `transmit()`; `receive()` processes exactly these. */
+    uint8_t queued_{0};
+
+    ec_master_state_t master_state_{};
+
+    motor_interface::DataState data_state_{motor_interface::DataState::Zero};
+
+    bool link_up_{true};
+
+    uint32_t cycles_since_master_state_{MASTER_STATE_INTERVAL};
 };
 
 } // namespace ethercat
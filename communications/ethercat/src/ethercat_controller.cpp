@@ -1,4 +1,3 @@
-#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -16,6 +15,7 @@ void ethercat::EthercatController::initialize(motor_interface::MotorMaster& mast
     if (!slave_config_) throw std::runtime_error("Failed to create slave config.");
 
     registerEntries();
+    addSdoRequests();
 
     ecrt_slave_config_dc(
         slave_config_,
@@ -36,17 +36,14 @@ void ethercat::EthercatController::registerEntries()
 bool ethercat::EthercatController::enable()
 {
     uint8_t* domain_pd = master_->domain_pd();
-    uint16_t sw = EC_READ_U16(domain_pd + offset_[ID_STATUSWORD]);
+    uint16_t sw = EC_READ_U16(domain_pd + tx_plan_.offset(ID_STATUSWORD));
 
     uint8_t sw_data[2];
     motor_interface::fill<uint16_t>(sw, sw_data);
 
     uint8_t cw_data[2]{0};
-    if (!(driver_->isEnabled(sw_data, current_driver_state_, cw_data))) {
-        EC_WRITE_U16(
-            domain_pd + offset_[ID_CONTROLWORD],
-            motor_interface::value<uint16_t>(cw_data)
-        );
+    if (!(driver_->isEnabled(sw_data, cia402_, cw_data))) {
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
         return false;
     }
     return true;
@@ -55,17 +52,14 @@ bool ethercat::EthercatController::enable()
 bool ethercat::EthercatController::disable()
 {
     uint8_t* domain_pd = master_->domain_pd();
-    uint16_t sw = EC_READ_U16(domain_pd + offset_[ID_STATUSWORD]);
+    uint16_t sw = EC_READ_U16(domain_pd + tx_plan_.offset(ID_STATUSWORD));
 
     uint8_t sw_data[2];
     motor_interface::fill<uint16_t>(sw, sw_data);
 
     uint8_t cw_data[2]{0};
-    if (!(driver_->isDisabled(sw_data, current_driver_state_, cw_data))) {
-        EC_WRITE_U16(
-            domain_pd + offset_[ID_CONTROLWORD],
-            motor_interface::value<uint16_t>(cw_data)
-        );
+    if (!(driver_->isDisabled(sw_data, cia402_, cw_data))) {
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
         return false;
     }
     return true;
@@ -73,188 +67,93 @@ bool ethercat::EthercatController::disable()
 
 void ethercat::EthercatController::check(const motor_interface::motor_frame_t& status)
 {
-    uint8_t* domain_pd = master_->domain_pd();
-
     uint8_t sw_data[2];
     motor_interface::fill<uint16_t>(status.statusword, sw_data);
 
     uint8_t cw_data[2]{0};
     if (driver_->isReceived(sw_data, cw_data)) {
-        EC_WRITE_U16(
-            domain_pd + offset_[ID_CONTROLWORD],
-            motor_interface::value<uint16_t>(cw_data)
-        );
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
     }
 }
 
 void ethercat::EthercatController::write(const motor_interface::motor_frame_t& command)
 {
-    motor_interface::entry_table_t rx_interfaces[motor_interface::MAX_INTERFACE_SIZE]{0};
-    const uint8_t n_rx = std::min(
-        command.number_of_target_interfaces,
-        motor_interface::MAX_INTERFACE_SIZE);
-    for (uint8_t i = 0; i < n_rx; ++i) {
-        if (command.target_interface_id[i] == ID_CONTROLWORD) {
-            rx_interfaces[i].id = ID_CONTROLWORD;
-            rx_interfaces[i].type = motor_interface::DataType::U16;
-            motor_interface::fill<uint16_t>(command.controlword, rx_interfaces[i].data);
-        } else if (command.target_interface_id[i] == ID_TARGET_POSITION) {
-            rx_interfaces[i].id = ID_TARGET_POSITION;
-            rx_interfaces[i].type = motor_interface::DataType::S32;
-            motor_interface::fill<int32_t>(
-                driver_->position(command.position),
-                rx_interfaces[i].data
-            );
-        } else if (command.target_interface_id[i] == ID_TARGET_VELOCITY) {
-            rx_interfaces[i].id = ID_TARGET_VELOCITY;
-            rx_interfaces[i].type = motor_interface::DataType::S32;
-            motor_interface::fill<int32_t>(
-                driver_->velocity(command.velocity),
-                rx_interfaces[i].data
-            );
-        } else if (command.target_interface_id[i] == ID_TARGET_TORQUE) {
-            rx_interfaces[i].id = ID_TARGET_TORQUE;
-            rx_interfaces[i].type = motor_interface::DataType::S16;
-            motor_interface::fill<int16_t>(
-                driver_->torque(command.torque),
-                rx_interfaces[i].data
-            );
-        } else {
-            throw std::runtime_error("Invalid RX interface ID.");
-        }
-    }
-    writeData(rx_interfaces, n_rx);
+    store(rx_values_, encode(command, rx_values_));
 }
 
 void ethercat::EthercatController::read(motor_interface::motor_frame_t& status)
 {
-    readData(tx_interfaces_, driver_->number_of_tx_interfaces());
-    for (uint8_t i = 0; i < driver_->number_of_tx_interfaces(); ++i) {
-        if (tx_interfaces_[i].id == ID_STATUSWORD) {
-            status.statusword = motor_interface::value<uint16_t>(tx_interfaces_[i].data);
-        } else if (tx_interfaces_[i].id == ID_ERRORCODE) {
-            status.errorcode = motor_interface::value<uint16_t>(tx_interfaces_[i].data);
-        } else if (tx_interfaces_[i].id == ID_CURRENT_POSITION) {
-            int32_t value = motor_interface::value<int32_t>(tx_interfaces_[i].data);
-            status.position = driver_->position(value);
-        } else if (tx_interfaces_[i].id == ID_CURRENT_VELOCITY) {
-            int32_t value = motor_interface::value<int32_t>(tx_interfaces_[i].data);
-            status.velocity = driver_->velocity(value);
-        } else if (tx_interfaces_[i].id == ID_CURRENT_TORQUE) {
-            int16_t value = motor_interface::value<int16_t>(tx_interfaces_[i].data);
-            status.torque = driver_->torque(value);
-        } else {
-            throw std::runtime_error("Invalid TX interface ID.");
-        }
-    }
-    status.controller_index = index_;
+    readData(tx_values_);
+    decode(tx_values_, status);
 }
 
-void ethercat::EthercatController::writeData(const motor_interface::entry_table_t* rx_interfaces, uint8_t number_of_rx_interfaces)
+bool ethercat::EthercatController::startSdo(const motor_interface::sdo_request_t& request)
 {
-    uint8_t* domain_pd = master_->domain_pd();
-    for (uint8_t i = 0; i < number_of_rx_interfaces; ++i) {
-        switch (rx_interfaces[i].type) {
-        case motor_interface::DataType::U8: {
-            EC_WRITE_U8(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<uint8_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::U16: {
-            EC_WRITE_U16(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<uint16_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::U32: {
-            EC_WRITE_U32(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<uint32_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::U64: {
-            EC_WRITE_U64(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<uint64_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::S8: {
-            EC_WRITE_S8(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<int8_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::S16: {
-            EC_WRITE_S16(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<int16_t>(rx_interfaces[i].data)
-            );
-            break;
-        } case motor_interface::DataType::S32: {
-            EC_WRITE_S32(
-                domain_pd + offset_[rx_interfaces[i].id],
-                motor_interface::value<int32_t>(rx_interfaces[i].data)
-            );
-            break;
-        } default: {
-            throw std::runtime_error("Invalid interface data type.");
+    if (sdo_active_) return false;
+
+    ec_sdo_request_t* sdo = sdo_requests_[2];
+    if (request.write) {
+        switch (request.size) {
+        case 1: sdo = sdo_requests_[0]; break;
+        case 2: sdo = sdo_requests_[1]; break;
+        case 4: sdo = sdo_requests_[2]; break;
+        default: return false;
         }
+    }
+
+    ecrt_sdo_request_index(sdo, request.index, request.subindex);
+    if (request.write) {
+        uint8_t* data = ecrt_sdo_request_data(sdo);
+        switch (request.size) {
+        case 1: EC_WRITE_U8(data, static_cast<uint8_t>(request.value)); break;
+        case 2: EC_WRITE_U16(data, static_cast<uint16_t>(request.value)); break;
+        default: EC_WRITE_U32(data, request.value); break;
         }
+        if (ecrt_sdo_request_write(sdo)) return false;
+    } else if (ecrt_sdo_request_read(sdo)) {
+        return false;
     }
+
+    sdo_active_ = sdo;
+    return true;
 }
 
-void ethercat::EthercatController::readData(motor_interface::entry_table_t* tx_interfaces, uint8_t number_of_tx_interfaces)
+motor_interface::SdoState ethercat::EthercatController::pollSdo(uint32_t& value)
 {
-    uint8_t* domain_pd = master_->domain_pd();
-    for (uint8_t i = 0; i < number_of_tx_interfaces; ++i) {
-        switch (tx_interfaces[i].type) {
-        case motor_interface::DataType::U8: {
-            motor_interface::fill<uint8_t>(
-                EC_READ_U8(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::U16: {
-            motor_interface::fill<uint16_t>(
-                EC_READ_U16(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::U32: {
-            motor_interface::fill<uint32_t>(
-                EC_READ_U32(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::U64: {
-            motor_interface::fill<uint64_t>(
-                EC_READ_U64(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::S8: {
-            motor_interface::fill<int8_t>(
-                EC_READ_S8(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::S16: {
-            motor_interface::fill<int16_t>(
-                EC_READ_S16(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } case motor_interface::DataType::S32: {
-            motor_interface::fill<int32_t>(
-                EC_READ_S32(domain_pd + offset_[tx_interfaces[i].id]),
-                tx_interfaces[i].data
-            );
-            break;
-        } default: {
-            throw std::runtime_error("Invalid interface data type.");
-        }
+    if (!sdo_active_) return motor_interface::SdoState::Failed;
+
+    switch (ecrt_sdo_request_state(sdo_active_)) {
+    case EC_REQUEST_BUSY: {
+        return motor_interface::SdoState::Busy;
+    } case EC_REQUEST_SUCCESS: {
+        const uint8_t* data = ecrt_sdo_request_data(sdo_active_);
+        const std::size_t size = ecrt_sdo_request_data_size(sdo_active_);
+        value = 0;
+        for (std::size_t i = 0; i < size && i < sizeof(value); ++i) {
+            value |= static_cast<uint32_t>(data[i]) << (i * 8);
         }
+        sdo_active_ = nullptr;
+        return motor_interface::SdoState::Done;
+    } default: {
+        sdo_active_ = nullptr;
+        return motor_interface::SdoState::Failed;
+    }
+    }
+}
+
+void ethercat::EthercatController::writeData(const int32_t* values, uint16_t mask)
+{
+    rx_plan_.store(master_->domain_pd(), values, mask);
+    for (uint8_t d = 1; d < number_of_domains_; ++d) {
+        rx_plans_[d - 1].store(master_->domain_pd(d), values, mask);
+    }
+}
+
+void ethercat::EthercatController::readData(int32_t* values)
+{
+    tx_plan_.load(master_->domain_pd(), values);
+    for (uint8_t d = 1; d < number_of_domains_; ++d) {
+        tx_plans_[d - 1].load(master_->domain_pd(d), values);
     }
 }
 
@@ -294,56 +193,48 @@ void ethercat::EthercatController::addSlaveConfigSdos()
     }
 }
 
+void ethercat::EthercatController::addSdoRequests()
+{
+    const std::size_t sizes[] = {1, 2, 4};
+    for (uint8_t i = 0; i < 3; ++i) {
+        sdo_requests_[i] = ecrt_slave_config_create_sdo_request(slave_config_, 0x1000, 0, sizes[i]);
+        if (!sdo_requests_[i]) throw std::runtime_error("Failed to create SDO request.");
+        ecrt_sdo_request_timeout(sdo_requests_[i], SDO_TIMEOUT);
+    }
+    sdo_active_ = nullptr;
+}
+
 void ethercat::EthercatController::addSlaveConfigPdos()
 {
     const motor_interface::entry_table_t* interfaces = driver_->interfaces();
 
-    uint8_t num_interfaces    = driver_->number_of_interfaces();
     uint8_t num_rx_interfaces = driver_->number_of_rx_interfaces();
     uint8_t num_tx_interfaces = driver_->number_of_tx_interfaces();
 
-    std::vector<ec_pdo_entry_info_t> pdo_entry_infos;
-    std::vector<ec_pdo_entry_reg_t> pdo_entry_regs;
-
-    pdo_entry_infos.reserve(num_interfaces - 2);
-    pdo_entry_regs.reserve(num_interfaces - 1);
-
     uint16_t rpdo_index = interfaces[0].index;
     uint16_t tpdo_index = interfaces[num_rx_interfaces + 1].index;
 
-    for (uint8_t i = 0; i < num_rx_interfaces; ++i) {
-        const motor_interface::entry_table_t& e = interfaces[i + 1];
-
-        pdo_entry_infos.push_back({
-            e.index,
-            e.subindex,
-            static_cast<uint8_t>(e.size * 8)
-        });
+    // Domain d maps its entries into RxPDO `rpdo_index + d` on SM `2 + 2d` and TxPDO `tpdo_index + d` on SM `3 + 2d`:
+    // the master moves whole sync managers, so entries exchanged at different rates need their own.
+    number_of_domains_ = master_->number_of_domains();
 
-        unsigned int& offset = offset_[e.id];
-        pdo_entry_regs.push_back({
-            alias_,
-            position_,
-            vendor_id_,
-            product_id_,
-            e.index,
-            e.subindex,
-            &offset,
-            0
-        });
-    }
+    std::vector<ec_pdo_entry_info_t> rx_entry_infos[motor_interface::MAX_DOMAIN_SIZE];
+    std::vector<ec_pdo_entry_info_t> tx_entry_infos[motor_interface::MAX_DOMAIN_SIZE];
+    std::vector<ec_pdo_entry_reg_t> pdo_entry_regs[motor_interface::MAX_DOMAIN_SIZE];
 
-    for (uint8_t i = 0; i < num_tx_interfaces; ++i) {
-        const motor_interface::entry_table_t& e = interfaces[i + num_rx_interfaces + 2];
+    auto add = [&](const motor_interface::entry_table_t& e, std::vector<ec_pdo_entry_info_t>* entry_infos) {
+        // Before `offset_` and `domainOf()` index by it: the plan would only reject the id after registration.
+        if (e.id >= motor_interface::NUMBER_OF_INTERFACE_IDS) throw std::runtime_error("Invalid interface ID.");
+        const uint8_t d = master_->domainOf(e.id);
 
-        pdo_entry_infos.push_back({
+        entry_infos[d].push_back({
             e.index,
             e.subindex,
             static_cast<uint8_t>(e.size * 8)
         });
 
         unsigned int& offset = offset_[e.id];
-        pdo_entry_regs.push_back({
+        pdo_entry_regs[d].push_back({
             alias_,
             position_,
             vendor_id_,
@@ -353,37 +244,73 @@ void ethercat::EthercatController::addSlaveConfigPdos()
             &offset,
             0
         });
+    };
 
-        tx_interfaces_[i] = motor_interface::entry_table_t{
-            e.id,
-            e.index,
-            e.subindex,
-            e.type,
-            e.size,
-            0
-        };
-    }
+    for (uint8_t i = 0; i < num_rx_interfaces; ++i) add(interfaces[i + 1], rx_entry_infos);
 
-    pdo_entry_regs.push_back(ec_pdo_entry_reg_t{});
+    for (uint8_t i = 0; i < num_tx_interfaces; ++i) add(interfaces[i + num_rx_interfaces + 2], tx_entry_infos);
 
-    ec_pdo_info_t pdo_infos[] = {
-        {rpdo_index, num_rx_interfaces, pdo_entry_infos.data()},
-        {tpdo_index, num_tx_interfaces, pdo_entry_infos.data() + num_rx_interfaces}
+    ec_pdo_info_t pdo_infos[2 * motor_interface::MAX_DOMAIN_SIZE];
+    std::vector<ec_sync_info_t> sync_infos{
+        {0, EC_DIR_OUTPUT, 0, nullptr, EC_WD_DISABLE},
+        {1, EC_DIR_INPUT,  0, nullptr, EC_WD_DISABLE}
     };
 
-    ec_sync_info_t sync_infos[] = {
-        {0, EC_DIR_OUTPUT, 0, nullptr,       EC_WD_DISABLE},
-        {1, EC_DIR_INPUT,  0, nullptr,       EC_WD_DISABLE},
-        {2, EC_DIR_OUTPUT, 1, pdo_infos,     EC_WD_ENABLE },
-        {3, EC_DIR_INPUT,  1, pdo_infos + 1, EC_WD_DISABLE},
-        {0xFF}
-    };
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        const uint8_t sync_index = static_cast<uint8_t>(2 + 2 * d);
+        if (!rx_entry_infos[d].empty()) {
+            ec_pdo_info_t& pdo = pdo_infos[2 * d];
+            pdo = {
+                static_cast<uint16_t>(rpdo_index + d),
+                static_cast<unsigned int>(rx_entry_infos[d].size()),
+                rx_entry_infos[d].data()
+            };
+            sync_infos.push_back({sync_index, EC_DIR_OUTPUT, 1, &pdo, d == 0 ? EC_WD_ENABLE : EC_WD_DEFAULT});
+        }
+        if (!tx_entry_infos[d].empty()) {
+            ec_pdo_info_t& pdo = pdo_infos[2 * d + 1];
+            pdo = {
+                static_cast<uint16_t>(tpdo_index + d),
+                static_cast<unsigned int>(tx_entry_infos[d].size()),
+                tx_entry_infos[d].data()
+            };
+            sync_infos.push_back({static_cast<uint8_t>(sync_index + 1), EC_DIR_INPUT, 1, &pdo, EC_WD_DISABLE});
+        }
+    }
+    sync_infos.push_back({0xFF});
 
-    if (ecrt_slave_config_pdos(slave_config_, EC_END, sync_infos)) {
+    if (ecrt_slave_config_pdos(slave_config_, EC_END, sync_infos.data())) {
         throw std::runtime_error("Failed to configure PDOs on slave.");
     }
 
-    if (ecrt_domain_reg_pdo_entry_list(master_->domain(), pdo_entry_regs.data())) {
-        throw std::runtime_error("Failed to register PDO entries on slave.");
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        if (pdo_entry_regs[d].empty()) continue;
+        pdo_entry_regs[d].push_back(ec_pdo_entry_reg_t{});
+        if (ecrt_domain_reg_pdo_entry_list(master_->domain(d), pdo_entry_regs[d].data())) {
+            throw std::runtime_error("Failed to register PDO entries on slave.");
+        }
+    }
+
+    rx_plan_.clear();
+    tx_plan_.clear();
+    for (uint8_t d = 1; d < number_of_domains_; ++d) {
+        rx_plans_[d - 1].clear();
+        tx_plans_[d - 1].clear();
+    }
+
+    rx_mask_ = 0;
+    for (uint8_t i = 0; i < num_rx_interfaces; ++i) {
+        const motor_interface::entry_table_t& e = interfaces[i + 1];
+        const uint8_t d = master_->domainOf(e.id);
+        (d == 0 ? rx_plan_ : rx_plans_[d - 1]).add(e.id, offset_[e.id], e.type);
+        rx_mask_ |= static_cast<uint16_t>(1u << e.id);
+    }
+
+    tx_mask_ = 0;
+    for (uint8_t i = 0; i < num_tx_interfaces; ++i) {
+        const motor_interface::entry_table_t& e = interfaces[i + num_rx_interfaces + 2];
+        const uint8_t d = master_->domainOf(e.id);
+        (d == 0 ? tx_plan_ : tx_plans_[d - 1]).add(e.id, offset_[e.id], e.type);
+        tx_mask_ |= static_cast<uint16_t>(1u << e.id);
     }
 }
@@ -1,21 +1,42 @@
+#include <algorithm>
 #include <stdexcept>
 
 #include "ethercat/ethercat_master.hpp"
 
+namespace {
+
+/** Refreshes `state` of `domain` and maps its working counter; values are ordered from best to worst. */
+motor_interface::DataState toDataState(ec_domain_t* domain, ec_domain_state_t& state)
+{
+    ecrt_domain_state(domain, &state);
+    switch (state.wc_state) {
+    case EC_WC_COMPLETE: return motor_interface::DataState::Complete;
+    case EC_WC_INCOMPLETE: return motor_interface::DataState::Incomplete;
+    default: return motor_interface::DataState::Zero;
+    }
+}
+
+} // namespace
+
 void ethercat::EthercatMaster::initialize()
 {
     master_ = ecrt_request_master(master_index_);
     if (master_ == nullptr) throw std::runtime_error("Failed to request master.");
 
-    domain_ = ecrt_master_create_domain(master_);
-    if (domain_ == nullptr) throw std::runtime_error("Failed to create domain.");
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        domains_[d] = ecrt_master_create_domain(master_);
+        if (domains_[d] == nullptr) throw std::runtime_error("Failed to create domain.");
+    }
 }
 
 void ethercat::EthercatMaster::activate()
 {
     if (ecrt_master_activate(master_)) throw std::runtime_error("Failed to activate master.");
 
-    if (!(domain_pd_ = ecrt_domain_data(domain_))) throw std::runtime_error("Failed to get domain data.");
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        if (!(domain_pds_[d] = ecrt_domain_data(domains_[d]))) throw std::runtime_error("Failed to get domain data.");
+    }
+    queued_ = 0;
 }
 
 void ethercat::EthercatMaster::deactivate()
@@ -23,18 +44,37 @@ void ethercat::EthercatMaster::deactivate()
     if (ecrt_master_deactivate(master_)) throw std::runtime_error("Failed to deactivate master.");
 }
 
-void ethercat::EthercatMaster::transmit()
+int ethercat::EthercatMaster::transmit()
 {
-    if (ecrt_domain_queue(domain_)) throw std::runtime_error("Failed to queue datagrams.");
+    queued_ = 0;
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        if (!(scheduled_ & (1u << d))) continue;
+        if (int rc = ecrt_domain_queue(domains_[d])) return rc;
+        queued_ |= static_cast<uint8_t>(1u << d);
+    }
 
-    if (ecrt_master_send(master_)) throw std::runtime_error("Failed to send datagrams.");
+    return ecrt_master_send(master_);
 }
 
-void ethercat::EthercatMaster::receive()
+int ethercat::EthercatMaster::receive()
 {
-    if (ecrt_master_receive(master_)) throw std::runtime_error("Failed to receive frames.");
+    if (int rc = ecrt_master_receive(master_)) return rc;
 
-    if (ecrt_domain_process(domain_)) throw std::runtime_error("Failed to determine the states of the domain.");
+    motor_interface::DataState state{motor_interface::DataState::Complete};
+    bool processed{false};
+    for (uint8_t d = 0; d < number_of_domains_; ++d) {
+        if (!(queued_ & (1u << d))) continue;
+        if (int rc = ecrt_domain_process(domains_[d])) return rc;
+        state = std::max(state, toDataState(domains_[d], domain_states_[d]));
+        processed = true;
+    }
+    if (processed) data_state_ = state;
+
+    if (++cycles_since_master_state_ >= MASTER_STATE_INTERVAL) {
+        cycles_since_master_state_ = 0;
+        if (ecrt_master_state(master_, &master_state_) == 0) link_up_ = master_state_.link_up;
+    }
+    return 0;
 }
 
 void ethercat::EthercatMaster::apply_application_time(const timespec& time)
@@ -48,3 +88,8 @@ void ethercat::EthercatMaster::save_clock()
 {
     ecrt_master_sync_slave_clocks(master_);
 }
+
+bool ethercat::EthercatMaster::reference_clock_time(uint32_t& time)
+{
+    return ecrt_master_reference_clock_time(master_, &time) == 0;
+}
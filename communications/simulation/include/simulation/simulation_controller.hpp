@@ -0,0 +1,49 @@
+#ifndef SIMULATION_SIMULATION_CONTROLLER_HPP_
+#define SIMULATION_SIMULATION_CONTROLLER_HPP_
+
+#include "motor_interface/motor_controller.hpp"
+#include "simulation/simulation_master.hpp"
+
+namespace simulation {
+
+class SimulationController : public motor_interface::MotorController {
+public:
+    explicit SimulationController(const motor_interface::slave_config_t& config)
+    : motor_interface::MotorController(config) {}
+
+    virtual ~SimulationController() = default;
+
+    void initialize(motor_interface::MotorMaster& master, motor_interface::MotorDriver& driver) override;
+
+    void registerEntries() override;
+
+    bool enable() override;
+
+    bool disable() override;
+
+    void check(const motor_interface::motor_frame_t& status) override;
+
+    void write(const motor_interface::motor_frame_t& command) override;
+
+    void read(motor_interface::motor_frame_t& status) override;
+
+    bool startSdo(const motor_interface::sdo_request_t& request) override;
+
+    motor_interface::SdoState pollSdo(uint32_t& value) override;
+
+    uint16_t slave_index() const { return slave_index_; }
+
+    SimulationMaster* master() const { return master_; }
+
+private:
+    void writeData(const int32_t* values, uint16_t mask) override;
+
+    void readData(int32_t* values) override;
+
+    SimulationMaster* master_{nullptr};
+
+    uint16_t slave_index_{0};
+};
+
+} // namespace simulation
+#endif // SIMULATION_SIMULATION_CONTROLLER_HPP_
@@ -0,0 +1,222 @@
+#ifndef SIMULATION_SIMULATION_MASTER_HPP_
+#define SIMULATION_SIMULATION_MASTER_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "motor_interface/cia402.hpp"
+#include "motor_interface/motor_master.hpp"
+#include "motor_interface/sdo_request.hpp"
+
+namespace simulation {
+
+inline constexpr uint32_t UNMAPPED = 0xFFFFFFFF;
+
+inline constexpr uint16_t SW_READY_TO_SWITCH_ON  = 0x0021;
+inline constexpr uint16_t SW_SWITCHED_ON         = 0x0023;
+inline constexpr uint16_t SW_OPERATION_ENABLED   = 0x0027;
+inline constexpr uint16_t SW_QUICK_STOP_ACTIVE   = 0x0007;
+inline constexpr uint16_t SW_FAULT               = 0x0008;
+inline constexpr uint16_t SW_SWITCH_ON_DISABLED  = 0x0040;
+inline constexpr uint16_t SW_SETPOINT_ACKNOWLEDGE = 0x1000;
+
+inline constexpr uint8_t MAX_SDO_OBJECTS = 32;
+
+/** `receive()` calls a simulated SDO transfer takes, standing in for mailbox round trips. */
+inline constexpr uint32_t SDO_LATENCY = 3;
+
+enum class SlaveState {
+    SwitchOnDisabled,
+    ReadyToSwitchOn,
+    SwitchedOn,
+    OperationEnabled,
+
+    /** Entered by a quick stop in operation enabled: targets are ignored and the drive stands still. */
+    QuickStopActive,
+    Fault
+};
+
+struct pdo_slot_t {
+    uint32_t offset{UNMAPPED};
+    uint8_t size{0};
+    uint8_t domain{0};
+};
+
+/** Object dictionary entry of a virtual slave. */
+struct sdo_object_t {
+    uint16_t index;
+    uint8_t subindex;
+    uint8_t size;
+    uint32_t value;
+};
+
+/** Recorded TX values a replayed slave reports instead of its simulated state, in raw counts. */
+struct replay_status_t {
+    uint16_t statusword;
+    uint16_t errorcode;
+    int32_t position;
+    int32_t velocity;
+    int32_t torque;
+    int8_t mode_display;
+};
+
+/** In-memory CiA402 drive: PDO slots in the master's process image plus first-order dynamics in raw counts. */
+struct virtual_slave_t {
+    pdo_slot_t controlword;
+    pdo_slot_t target_position;
+    pdo_slot_t target_velocity;
+    pdo_slot_t target_torque;
+    pdo_slot_t statusword;
+    pdo_slot_t errorcode;
+    pdo_slot_t current_position;
+    pdo_slot_t current_velocity;
+    pdo_slot_t current_torque;
+    pdo_slot_t mode_of_operation;
+    pdo_slot_t mode_display;
+
+    SlaveState state{SlaveState::SwitchOnDisabled};
+    uint16_t last_controlword{0};
+    uint16_t error{0};
+    uint16_t pending_error{0};
+
+    /** Outputs as last delivered by their domain; a domain not exchanged this cycle leaves them unchanged. */
+    int64_t controlword_value{0};
+    int64_t target_position_value{0};
+    int64_t target_velocity_value{0};
+    int64_t target_torque_value{0};
+    int64_t mode_value{0};
+
+    /** Active mode of operation (CSP / CSV / CST); starts as the driver's 0x6060 startup item, else CSP. */
+    int8_t mode{static_cast<int8_t>(motor_interface::OperationMode::CyclicSyncPosition)};
+
+    double position{0.0};
+    double velocity{0.0};
+    double torque{0.0};
+
+    /** SDO-accessible objects (seeded from the driver's startup items); statusword and error code are served live. */
+    sdo_object_t objects[MAX_SDO_OBJECTS]{};
+    uint8_t number_of_objects{0};
+
+    motor_interface::sdo_request_t sdo{};
+    bool sdo_busy{false};
+    uint32_t sdo_due{0};
+
+    /** Set by `SimulationMaster::replay()`: publish `replay` and skip the state machine and dynamics. */
+    bool replayed{false};
+    replay_status_t replay{};
+};
+
+class SimulationMaster : public motor_interface::MotorMaster {
+public:
+    explicit SimulationMaster(const motor_interface::master_config_t& config)
+    : motor_interface::MotorMaster(config)
+    , time_constant_(config.time_constant)
+    , clock_drift_(config.clock_drift)
+    , bus_error_after_(config.bus_error_after)
+    , bus_error_cycles_(config.bus_error_cycles)
+    , frame_loss_after_(config.frame_loss_after)
+    , frame_loss_cycles_(config.frame_loss_cycles) {}
+
+    virtual ~SimulationMaster() = default;
+
+    virtual void initialize() override;
+
+    virtual void activate() override;
+
+    virtual void deactivate() override;
+
+    virtual int transmit() override;
+
+    virtual int receive() override;
+
+    virtual void apply_application_time(const timespec& time) override;
+
+    virtual void save_clock() override;
+
+    virtual bool reference_clock_time(uint32_t& time) override;
+
+    virtual motor_interface::DataState data_state() const override { return data_state_; }
+
+    /** Reserves `size` bytes of process image; only valid before `activate()`. */
+    uint32_t allocate(uint8_t size);
+
+    /** Adds a virtual drive and returns its index; only valid before `activate()`. */
+    uint16_t add_slave(const virtual_slave_t& slave);
+
+    /** Latches `errorcode` on `slave`; the drive enters Fault on the next `receive()`. */
+    void inject_fault(uint16_t slave, uint16_t errorcode);
+
+    /** Log replay: from the next `receive()` on, `slave` reports `status` until called again. */
+    void replay(uint16_t slave, const replay_status_t& status);
+
+    /** The next `cycles` calls to `receive()` fail with `-EIO` without touching the process image. */
+    void inject_bus_error(uint32_t cycles) { bus_errors_.store(cycles, std::memory_order_relaxed); }
+
+    /** Offline runs: the reference clock advances with `time` (ns) instead of `CLOCK_MONOTONIC` from the next `transmit()` on. */
+    void set_monotonic_time(uint64_t time) { virtual_monotonic_ = time; }
+
+    /** Starts an SDO transfer on `slave`'s object dictionary; it completes `SDO_LATENCY` receives later. */
+    bool start_sdo(uint16_t slave, const motor_interface::sdo_request_t& request);
+
+    /** Unknown objects and writes of the wrong size fail, like an SDO abort. */
+    motor_interface::SdoState poll_sdo(uint16_t slave, uint32_t& value);
+
+    const virtual_slave_t& slave(uint16_t index) const { return slaves_.at(index); }
+
+    uint8_t* process_data() { return image_.data(); }
+
+    std::size_t process_data_size() const { return image_.size(); }
+
+private:
+    void step(virtual_slave_t& slave, double dt);
+
+    std::vector<uint8_t> image_;
+
+    std::vector<virtual_slave_t> slaves_;
+
+    uint64_t application_time_{0};
+
+    uint64_t last_step_time_{0};
+
+    const double time_constant_{0.0};
+
+    /** Reference clock rate error against `CLOCK_MONOTONIC` in ppm. */
+    const double clock_drift_{0.0};
+
+    /** Reference clock: starts at the first application time, then runs at `1 + clock_drift_` ppm on monotonic time. */
+    uint64_t reference_origin_{0};
+
+    uint64_t monotonic_origin_{0};
+
+    /** Set by `set_monotonic_time()`; `0` while the reference clock follows `CLOCK_MONOTONIC`. */
+    uint64_t virtual_monotonic_{0};
+
+    uint64_t reference_time_{0};
+
+    bool reference_valid_{false};
+
+    std::atomic<uint32_t> bus_errors_{0};
+
+    /** Scripted bus error: `receive()` number `bus_error_after_` starts `bus_error_cycles_` failures. */
+    const uint32_t bus_error_after_{0};
+
+    const uint32_t bus_error_cycles_{0};
+
+    uint32_t receives_{0};
+
+    /** Scripted frame loss: from `receive()` number `frame_loss_after_`, `frame_loss_cycles_` cycles return with working counter zero. */
+    const uint32_t frame_loss_after_{0};
+
+    const uint32_t frame_loss_cycles_{0};
+
+    uint32_t frames_lost_{0};
+
+    motor_interface::DataState data_state_{motor_interface::DataState::Complete};
+
+    /** Domains sent by the last `transmit()`; `receive()` only exchanges their slots with the drives. */
+    uint8_t queued_{motor_interface::ALL_DOMAINS};
+};
+
+} // namespace simulation
+#endif // SIMULATION_SIMULATION_MASTER_HPP_
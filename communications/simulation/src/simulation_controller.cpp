@@ -0,0 +1,164 @@
+#include <cstring>
+#include <stdexcept>
+
+#include "simulation/simulation_controller.hpp"
+
+namespace {
+
+uint8_t sizeOf(motor_interface::DataType type)
+{
+    switch (type) {
+    case motor_interface::DataType::U8:
+    case motor_interface::DataType::S8: return 1;
+    case motor_interface::DataType::U16:
+    case motor_interface::DataType::S16: return 2;
+    case motor_interface::DataType::U32:
+    case motor_interface::DataType::S32: return 4;
+    case motor_interface::DataType::U64: return 8;
+    }
+    throw std::runtime_error("Invalid interface data type.");
+}
+
+simulation::pdo_slot_t* slotOf(simulation::virtual_slave_t& slave, uint8_t id)
+{
+    switch (id) {
+    case motor_interface::ID_CONTROLWORD: return &slave.controlword;
+    case motor_interface::ID_TARGET_POSITION: return &slave.target_position;
+    case motor_interface::ID_TARGET_VELOCITY: return &slave.target_velocity;
+    case motor_interface::ID_TARGET_TORQUE: return &slave.target_torque;
+    case motor_interface::ID_STATUSWORD: return &slave.statusword;
+    case motor_interface::ID_ERRORCODE: return &slave.errorcode;
+    case motor_interface::ID_CURRENT_POSITION: return &slave.current_position;
+    case motor_interface::ID_CURRENT_VELOCITY: return &slave.current_velocity;
+    case motor_interface::ID_CURRENT_TORQUE: return &slave.current_torque;
+    case motor_interface::ID_MODE_OF_OPERATION: return &slave.mode_of_operation;
+    case motor_interface::ID_MODE_OF_OPERATION_DISPLAY: return &slave.mode_display;
+    default: return nullptr;
+    }
+}
+
+} // namespace
+
+void simulation::SimulationController::initialize(motor_interface::MotorMaster& master, motor_interface::MotorDriver& driver)
+{
+    SimulationMaster* m = dynamic_cast<SimulationMaster*>(&master);
+    if (!m) throw std::runtime_error("Failed to cast master to SimulationMaster.");
+
+    master_ = m;
+    driver_ = &driver;
+
+    registerEntries();
+}
+
+void simulation::SimulationController::registerEntries()
+{
+    const motor_interface::entry_table_t* interfaces = driver_->interfaces();
+
+    const uint8_t num_rx_interfaces = driver_->number_of_rx_interfaces();
+    const uint8_t num_tx_interfaces = driver_->number_of_tx_interfaces();
+
+    virtual_slave_t slave{};
+    auto map = [&](const motor_interface::entry_table_t& e, motor_interface::PdoPlan& plan) {
+        const uint8_t size = e.size ? e.size : sizeOf(e.type);
+        const uint32_t offset = master_->allocate(size);
+
+        pdo_slot_t* slot = slotOf(slave, e.id);
+        if (!slot) throw std::runtime_error("Invalid interface ID for simulated slave.");
+        *slot = pdo_slot_t{offset, size, master_->domainOf(e.id)};
+
+        plan.add(e.id, offset, e.type);
+    };
+
+    rx_plan_.clear();
+    for (uint8_t i = 0; i < num_rx_interfaces; ++i) {
+        map(interfaces[i + 1], rx_plan_);
+    }
+    rx_mask_ = rx_plan_.mask();
+
+    tx_plan_.clear();
+    for (uint8_t i = 0; i < num_tx_interfaces; ++i) {
+        map(interfaces[i + num_rx_interfaces + 2], tx_plan_);
+    }
+    tx_mask_ = tx_plan_.mask();
+
+    const motor_interface::entry_table_t* items = driver_->items();
+    for (uint8_t i = 0; i < driver_->number_of_items() && slave.number_of_objects < MAX_SDO_OBJECTS; ++i) {
+        const uint8_t size = sizeOf(items[i].type);
+        if (size > sizeof(uint32_t)) continue;
+
+        uint32_t value{0};
+        for (uint8_t b = 0; b < size; ++b) value |= static_cast<uint32_t>(items[i].data[b]) << (b * 8);
+        slave.objects[slave.number_of_objects++] = sdo_object_t{items[i].index, items[i].subindex, size, value};
+        if (items[i].index == motor_interface::OD_MODE_OF_OPERATION && items[i].subindex == 0) slave.mode = static_cast<int8_t>(value);
+    }
+
+    slave_index_ = master_->add_slave(slave);
+}
+
+bool simulation::SimulationController::enable()
+{
+    uint8_t sw_data[2];
+    std::memcpy(sw_data, master_->process_data() + tx_plan_.offset(motor_interface::ID_STATUSWORD), sizeof(sw_data));
+
+    uint8_t cw_data[2]{0};
+    if (!(driver_->isEnabled(sw_data, cia402_, cw_data))) {
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
+        return false;
+    }
+    return true;
+}
+
+bool simulation::SimulationController::disable()
+{
+    uint8_t sw_data[2];
+    std::memcpy(sw_data, master_->process_data() + tx_plan_.offset(motor_interface::ID_STATUSWORD), sizeof(sw_data));
+
+    uint8_t cw_data[2]{0};
+    if (!(driver_->isDisabled(sw_data, cia402_, cw_data))) {
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
+        return false;
+    }
+    return true;
+}
+
+void simulation::SimulationController::check(const motor_interface::motor_frame_t& status)
+{
+    uint8_t sw_data[2];
+    motor_interface::fill<uint16_t>(status.statusword, sw_data);
+
+    uint8_t cw_data[2]{0};
+    if (driver_->isReceived(sw_data, cw_data)) {
+        writeControlword(motor_interface::value<uint16_t>(cw_data));
+    }
+}
+
+void simulation::SimulationController::write(const motor_interface::motor_frame_t& command)
+{
+    store(rx_values_, encode(command, rx_values_));
+}
+
+void simulation::SimulationController::read(motor_interface::motor_frame_t& status)
+{
+    readData(tx_values_);
+    decode(tx_values_, status);
+}
+
+bool simulation::SimulationController::startSdo(const motor_interface::sdo_request_t& request)
+{
+    return master_->start_sdo(slave_index_, request);
+}
+
+motor_interface::SdoState simulation::SimulationController::pollSdo(uint32_t& value)
+{
+    return master_->poll_sdo(slave_index_, value);
+}
+
+void simulation::SimulationController::writeData(const int32_t* values, uint16_t mask)
+{
+    rx_plan_.store(master_->process_data(), values, mask);
+}
+
+void simulation::SimulationController::readData(int32_t* values)
+{
+    tx_plan_.load(master_->process_data(), values);
+}
@@ -0,0 +1,347 @@
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include <time.h>
+
+#include "simulation/simulation_master.hpp"
+
+namespace {
+
+constexpr uint16_t CW_FAULT_RESET_BIT = 0x0080;
+constexpr uint16_t CW_NEW_SETPOINT_BIT = 0x0010;
+constexpr uint16_t CW_HALT_BIT = 0x0100;
+
+bool isDisableVoltage(uint16_t cw)
+{
+    return (cw & 0x0082) == 0x0000;
+}
+
+bool isQuickStop(uint16_t cw)
+{
+    return (cw & 0x0086) == 0x0002;
+}
+
+bool isShutdown(uint16_t cw)
+{
+    return (cw & 0x0087) == 0x0006;
+}
+
+bool isSwitchOn(uint16_t cw)
+{
+    return (cw & 0x008F) == 0x0007;
+}
+
+bool isEnableOperation(uint16_t cw)
+{
+    return (cw & 0x008F) == 0x000F;
+}
+
+int64_t load(const uint8_t* image, const simulation::pdo_slot_t& slot)
+{
+    if (slot.offset == simulation::UNMAPPED || slot.size == 0) return 0;
+
+    uint64_t u{0};
+    for (uint8_t i = 0; i < slot.size; ++i) {
+        u |= static_cast<uint64_t>(image[slot.offset + i]) << (i * 8);
+    }
+    const uint8_t unused = static_cast<uint8_t>(64 - slot.size * 8);
+    return static_cast<int64_t>(u << unused) >> unused;
+}
+
+void store(uint8_t* image, const simulation::pdo_slot_t& slot, int64_t value)
+{
+    if (slot.offset == simulation::UNMAPPED) return;
+
+    const uint64_t u = static_cast<uint64_t>(value);
+    for (uint8_t i = 0; i < slot.size; ++i) {
+        image[slot.offset + i] = static_cast<uint8_t>((u >> (i * 8)) & 0xFF);
+    }
+}
+
+int64_t deliver(const uint8_t* image, const simulation::pdo_slot_t& slot, uint8_t queued, int64_t& value)
+{
+    if (queued & (1u << slot.domain)) value = load(image, slot);
+    return value;
+}
+
+void publish(uint8_t* image, const simulation::pdo_slot_t& slot, uint8_t queued, int64_t value)
+{
+    if (queued & (1u << slot.domain)) store(image, slot, value);
+}
+
+uint16_t statusword(simulation::SlaveState state)
+{
+    switch (state) {
+    case simulation::SlaveState::SwitchOnDisabled: return simulation::SW_SWITCH_ON_DISABLED;
+    case simulation::SlaveState::ReadyToSwitchOn: return simulation::SW_READY_TO_SWITCH_ON;
+    case simulation::SlaveState::SwitchedOn: return simulation::SW_SWITCHED_ON;
+    case simulation::SlaveState::OperationEnabled: return simulation::SW_OPERATION_ENABLED;
+    case simulation::SlaveState::QuickStopActive: return simulation::SW_QUICK_STOP_ACTIVE;
+    case simulation::SlaveState::Fault: return simulation::SW_FAULT;
+    }
+    return simulation::SW_FAULT;
+}
+
+} // namespace
+
+void simulation::SimulationMaster::initialize()
+{
+    image_.clear();
+    slaves_.clear();
+}
+
+void simulation::SimulationMaster::activate()
+{
+    if (slaves_.size() != number_of_slaves_) throw std::runtime_error("Simulated slave count does not match configuration.");
+
+    std::memset(image_.data(), 0, image_.size());
+    for (auto& s : slaves_) {
+        s.state = SlaveState::SwitchOnDisabled;
+        s.sdo_busy = false;
+        s.replayed = false;
+        store(image_.data(), s.statusword, SW_SWITCH_ON_DISABLED);
+    }
+    last_step_time_ = 0;
+    receives_ = 0;
+    queued_ = motor_interface::ALL_DOMAINS;
+    reference_valid_ = false;
+    monotonic_origin_ = 0;
+}
+
+void simulation::SimulationMaster::deactivate()
+{
+}
+
+int simulation::SimulationMaster::transmit()
+{
+    uint64_t monotonic = virtual_monotonic_;
+    if (monotonic == 0) {
+        timespec now{};
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        monotonic = static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+    }
+    if (monotonic_origin_ == 0) {
+        monotonic_origin_ = monotonic;
+        reference_origin_ = application_time_;
+    }
+
+    const double elapsed = static_cast<double>(monotonic - monotonic_origin_);
+    reference_time_ = reference_origin_ + static_cast<uint64_t>(std::llround(elapsed * (1.0 + clock_drift_ * 1e-6)));
+    reference_valid_ = true;
+    queued_ = scheduled_;
+    return 0;
+}
+
+int simulation::SimulationMaster::receive()
+{
+    ++receives_;
+    if (bus_error_cycles_ > 0 && receives_ == bus_error_after_) inject_bus_error(bus_error_cycles_);
+    if (frame_loss_cycles_ > 0 && receives_ == frame_loss_after_) frames_lost_ = frame_loss_cycles_;
+
+    const uint32_t errors = bus_errors_.load(std::memory_order_relaxed);
+    if (errors > 0) {
+        bus_errors_.store(errors - 1, std::memory_order_relaxed);
+        return -EIO;
+    }
+
+    if (frames_lost_ > 0) {
+        frames_lost_--;
+        data_state_ = motor_interface::DataState::Zero;
+        return 0;
+    }
+    data_state_ = motor_interface::DataState::Complete;
+
+    const double dt = last_step_time_ == 0 ? 0.0 : static_cast<double>(application_time_ - last_step_time_) * 1e-9;
+    last_step_time_ = application_time_;
+
+    for (auto& s : slaves_) step(s, dt);
+    return 0;
+}
+
+void simulation::SimulationMaster::apply_application_time(const timespec& time)
+{
+    application_time_ =
+        static_cast<uint64_t>(time.tv_sec) * 1000000000ULL + static_cast<uint64_t>(time.tv_nsec);
+}
+
+void simulation::SimulationMaster::save_clock()
+{
+}
+
+bool simulation::SimulationMaster::reference_clock_time(uint32_t& time)
+{
+    if (!reference_valid_) return false;
+    time = static_cast<uint32_t>(reference_time_);
+    return true;
+}
+
+uint32_t simulation::SimulationMaster::allocate(uint8_t size)
+{
+    const uint32_t offset = static_cast<uint32_t>(image_.size());
+    image_.resize(image_.size() + size, 0);
+    return offset;
+}
+
+uint16_t simulation::SimulationMaster::add_slave(const virtual_slave_t& slave)
+{
+    slaves_.push_back(slave);
+    return static_cast<uint16_t>(slaves_.size() - 1);
+}
+
+void simulation::SimulationMaster::inject_fault(uint16_t slave, uint16_t errorcode)
+{
+    slaves_.at(slave).pending_error = errorcode;
+}
+
+void simulation::SimulationMaster::replay(uint16_t slave, const replay_status_t& status)
+{
+    virtual_slave_t& s = slaves_.at(slave);
+    s.replayed = true;
+    s.replay = status;
+}
+
+bool simulation::SimulationMaster::start_sdo(uint16_t slave, const motor_interface::sdo_request_t& request)
+{
+    virtual_slave_t& s = slaves_.at(slave);
+    if (s.sdo_busy) return false;
+
+    s.sdo = request;
+    s.sdo_busy = true;
+    s.sdo_due = receives_ + SDO_LATENCY;
+    return true;
+}
+
+motor_interface::SdoState simulation::SimulationMaster::poll_sdo(uint16_t slave, uint32_t& value)
+{
+    virtual_slave_t& s = slaves_.at(slave);
+    if (!s.sdo_busy) return motor_interface::SdoState::Failed;
+    if (static_cast<int32_t>(receives_ - s.sdo_due) < 0) return motor_interface::SdoState::Busy;
+    s.sdo_busy = false;
+
+    const motor_interface::sdo_request_t& r = s.sdo;
+    if (!r.write && r.subindex == 0 && r.index == 0x6041) {
+        value = statusword(s.state);
+        return motor_interface::SdoState::Done;
+    }
+    if (!r.write && r.subindex == 0 && r.index == 0x603F) {
+        value = s.error;
+        return motor_interface::SdoState::Done;
+    }
+
+    for (uint8_t i = 0; i < s.number_of_objects; ++i) {
+        sdo_object_t& object = s.objects[i];
+        if (object.index != r.index || object.subindex != r.subindex) continue;
+        if (!r.write) {
+            value = object.value;
+            return motor_interface::SdoState::Done;
+        }
+        if (r.size != object.size) return motor_interface::SdoState::Failed;
+        object.value = r.value;
+        return motor_interface::SdoState::Done;
+    }
+    return motor_interface::SdoState::Failed;
+}
+
+void simulation::SimulationMaster::step(virtual_slave_t& slave, double dt)
+{
+    uint8_t* image = image_.data();
+    const uint16_t cw = static_cast<uint16_t>(deliver(image, slave.controlword, queued_, slave.controlword_value));
+    if (slave.replayed) {
+        publish(image, slave.statusword, queued_, slave.replay.statusword);
+        publish(image, slave.errorcode, queued_, slave.replay.errorcode);
+        publish(image, slave.current_position, queued_, slave.replay.position);
+        publish(image, slave.current_velocity, queued_, slave.replay.velocity);
+        publish(image, slave.current_torque, queued_, slave.replay.torque);
+        publish(image, slave.mode_display, queued_, slave.replay.mode_display);
+        return;
+    }
+
+    const bool fault_reset = (cw & CW_FAULT_RESET_BIT) && !(slave.last_controlword & CW_FAULT_RESET_BIT);
+    slave.last_controlword = cw;
+
+    if (slave.pending_error != 0) {
+        slave.error = slave.pending_error;
+        slave.pending_error = 0;
+        slave.state = SlaveState::Fault;
+    }
+
+    switch (slave.state) {
+    case SlaveState::Fault: {
+        if (fault_reset) {
+            slave.error = 0;
+            slave.state = SlaveState::SwitchOnDisabled;
+        }
+        break;
+    } case SlaveState::SwitchOnDisabled: {
+        if (isShutdown(cw)) slave.state = SlaveState::ReadyToSwitchOn;
+        break;
+    } case SlaveState::ReadyToSwitchOn: {
+        if (isDisableVoltage(cw) || isQuickStop(cw)) slave.state = SlaveState::SwitchOnDisabled;
+        else if (isSwitchOn(cw)) slave.state = SlaveState::SwitchedOn;
+        break;
+    } case SlaveState::SwitchedOn: {
+        if (isDisableVoltage(cw) || isQuickStop(cw)) slave.state = SlaveState::SwitchOnDisabled;
+        else if (isShutdown(cw)) slave.state = SlaveState::ReadyToSwitchOn;
+        else if (isEnableOperation(cw)) slave.state = SlaveState::OperationEnabled;
+        break;
+    } case SlaveState::OperationEnabled: {
+        if (isDisableVoltage(cw)) slave.state = SlaveState::SwitchOnDisabled;
+        else if (isQuickStop(cw)) slave.state = SlaveState::QuickStopActive;
+        else if (isShutdown(cw)) slave.state = SlaveState::ReadyToSwitchOn;
+        else if (isSwitchOn(cw)) slave.state = SlaveState::SwitchedOn;
+        break;
+    } case SlaveState::QuickStopActive: {
+        if (isDisableVoltage(cw)) slave.state = SlaveState::SwitchOnDisabled;
+        else if (isEnableOperation(cw)) slave.state = SlaveState::OperationEnabled;
+        break;
+    }
+    }
+
+    if (slave.mode_of_operation.offset != UNMAPPED) {
+        const int64_t mode = deliver(image, slave.mode_of_operation, queued_, slave.mode_value);
+        if (motor_interface::isCyclicMode(static_cast<int8_t>(mode))) slave.mode = static_cast<int8_t>(mode);
+    }
+
+    const double previous = slave.position;
+    bool velocity_mode{false};
+    if (slave.state == SlaveState::OperationEnabled) {
+        const double alpha = time_constant_ > 0.0 ? 1.0 - std::exp(-dt / time_constant_) : 1.0;
+        const int64_t target_position = deliver(image, slave.target_position, queued_, slave.target_position_value);
+        const int64_t target_velocity = deliver(image, slave.target_velocity, queued_, slave.target_velocity_value);
+        // Halt: the targets are taken but not followed, so the drive stands at its position until the bit clears.
+        if (!(cw & CW_HALT_BIT)) {
+            switch (static_cast<motor_interface::OperationMode>(slave.mode)) {
+            case motor_interface::OperationMode::CyclicSyncPosition: {
+                if (slave.target_position.offset != UNMAPPED) {
+                    slave.position += (static_cast<double>(target_position) - slave.position) * alpha;
+                }
+                break;
+            } case motor_interface::OperationMode::CyclicSyncVelocity: {
+                slave.velocity += (static_cast<double>(target_velocity) - slave.velocity) * alpha;
+                slave.position += slave.velocity * dt;
+                velocity_mode = true;
+                break;
+            } case motor_interface::OperationMode::CyclicSyncTorque: {
+                break;  // no load model: the position holds
+            }
+            }
+        }
+        const int64_t target_torque = deliver(image, slave.target_torque, queued_, slave.target_torque_value);
+        slave.torque += (static_cast<double>(target_torque) - slave.torque) * alpha;
+    } else {
+        slave.torque = 0.0;
+    }
+    if (!velocity_mode) slave.velocity = dt > 0.0 ? (slave.position - previous) / dt : 0.0;
+
+    uint16_t sw = statusword(slave.state);
+    if (slave.state == SlaveState::OperationEnabled && (cw & CW_NEW_SETPOINT_BIT)) sw |= SW_SETPOINT_ACKNOWLEDGE;
+
+    publish(image, slave.statusword, queued_, sw);
+    publish(image, slave.errorcode, queued_, slave.error);
+    publish(image, slave.current_position, queued_, std::llround(slave.position));
+    publish(image, slave.current_velocity, queued_, std::llround(slave.velocity));
+    publish(image, slave.current_torque, queued_, std::llround(slave.torque));
+    publish(image, slave.mode_display, queued_, slave.mode);
+}
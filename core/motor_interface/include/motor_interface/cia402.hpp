@@ -0,0 +1,217 @@
+#ifndef MOTOR_INTERFACE_CIA402_HPP_
+#define MOTOR_INTERFACE_CIA402_HPP_
+
+#include <cstdint>
+
+namespace motor_interface {
+
+/** CiA402 power state, decoded from the statusword every cycle. */
+enum class DriverState : uint8_t {
+    Fault,
+    SwitchOnDisabled,
+    ReadyToSwitchOn,
+    SwitchedOn,
+    OperationEnabled,
+    QuickStopActive,
+    FaultReactionActive,
+    NotReadyToSwitchOn
+};
+
+inline constexpr uint8_t NUMBER_OF_DRIVER_STATES = 8;
+
+/** Modes of operation (0x6060 / 0x6061) the cyclic path switches between. */
+enum class OperationMode : int8_t {
+    CyclicSyncPosition = 8,
+    CyclicSyncVelocity = 9,
+    CyclicSyncTorque = 10
+};
+
+/** Object index of modes of operation; a startup `items` entry with it sets the mode the cyclic path starts in. */
+inline constexpr uint16_t OD_MODE_OF_OPERATION = 0x6060;
+
+constexpr bool isCyclicMode(int8_t mode)
+{
+    return mode == static_cast<int8_t>(OperationMode::CyclicSyncPosition) ||
+        mode == static_cast<int8_t>(OperationMode::CyclicSyncVelocity) ||
+        mode == static_cast<int8_t>(OperationMode::CyclicSyncTorque);
+}
+
+/** State a `step()` drives an axis toward. */
+enum class Cia402Goal : uint8_t {
+    Enable,
+
+    /** Switch-on disabled; a faulted or not-ready drive counts as disabled. */
+    Disable,
+
+    QuickStop,
+
+    /** Operation enabled with the halt bit set. */
+    Halt
+};
+
+inline constexpr uint8_t NUMBER_OF_CIA402_GOALS = 4;
+
+/** A statusword is in the state when `(statusword & mask) == value`. */
+struct state_pattern_t {
+    uint16_t mask;
+    uint16_t value;
+};
+
+/** Controlwords a vendor expects for the CiA402 commands. */
+struct cia402_controlwords_t {
+    uint16_t shutdown;
+    uint16_t switch_on;
+    uint16_t enable_operation;
+    uint16_t disable_voltage;
+    uint16_t quick_stop;
+    uint16_t fault_reset;
+
+    /** Sent in every state on the way to switch-on disabled. */
+    uint16_t disable;
+
+    /** Bit ORed into `enable_operation` while halting. */
+    uint16_t halt;
+};
+
+/** Transition table of one vendor; built at compile time by `cia402Descriptor()`. */
+struct cia402_descriptor_t {
+    /** By `DriverState`; patterns do not overlap. A statusword matching none decodes as `NotReadyToSwitchOn`. */
+    state_pattern_t patterns[NUMBER_OF_DRIVER_STATES];
+
+    /** By goal and decoded state: the controlword to write this cycle. */
+    uint16_t controlwords[NUMBER_OF_CIA402_GOALS][NUMBER_OF_DRIVER_STATES];
+
+    /** By goal: one bit per `DriverState` in which the goal counts as reached. */
+    uint8_t reached[NUMBER_OF_CIA402_GOALS];
+
+    /** By state: cycles an axis may stay in it short of its goal before `retry` is sent once; `0` waits forever. */
+    uint16_t timeouts[NUMBER_OF_DRIVER_STATES];
+
+    /** Clears the fault reset bit (a fresh edge for the next reset) and drops the drive back to the start of the walk. */
+    uint16_t retry;
+};
+
+/** Engine state of one axis. */
+struct cia402_axis_t {
+    /** Decoded last cycle. */
+    DriverState state{DriverState::NotReadyToSwitchOn};
+
+    /** Cycles `state` has been observed in a row. */
+    uint16_t cycles{0};
+
+    /** States that outlasted their timeout. */
+    uint32_t timeouts{0};
+};
+
+constexpr uint8_t stateBit(DriverState state)
+{
+    return static_cast<uint8_t>(1u << static_cast<uint8_t>(state));
+}
+
+/**
+ * Standard CiA402 table over `controlwords`. Only the switch-on disabled pattern varies between the supported
+ * vendors; `fault_reset_timeout` bounds the wait for a fault reset, `transition_timeout` every other commanded one.
+ */
+constexpr cia402_descriptor_t cia402Descriptor(
+    const cia402_controlwords_t& controlwords,
+    const state_pattern_t& switch_on_disabled,
+    uint16_t fault_reset_timeout,
+    uint16_t transition_timeout)
+{
+    using S = DriverState;
+    cia402_descriptor_t d{};
+
+    d.patterns[static_cast<uint8_t>(S::Fault)] = {0x004F, 0x0008};
+    d.patterns[static_cast<uint8_t>(S::SwitchOnDisabled)] = switch_on_disabled;
+    d.patterns[static_cast<uint8_t>(S::ReadyToSwitchOn)] = {0x006F, 0x0021};
+    d.patterns[static_cast<uint8_t>(S::SwitchedOn)] = {0x006F, 0x0023};
+    d.patterns[static_cast<uint8_t>(S::OperationEnabled)] = {0x006F, 0x0027};
+    d.patterns[static_cast<uint8_t>(S::QuickStopActive)] = {0x006F, 0x0007};
+    d.patterns[static_cast<uint8_t>(S::FaultReactionActive)] = {0x004F, 0x000F};
+    d.patterns[static_cast<uint8_t>(S::NotReadyToSwitchOn)] = {0x004F, 0x0000};
+
+    for (uint8_t s = 0; s < NUMBER_OF_DRIVER_STATES; ++s) {
+        d.controlwords[static_cast<uint8_t>(Cia402Goal::Enable)][s] = controlwords.disable_voltage;
+        d.controlwords[static_cast<uint8_t>(Cia402Goal::Disable)][s] = controlwords.disable;
+        d.controlwords[static_cast<uint8_t>(Cia402Goal::QuickStop)][s] = controlwords.quick_stop;
+        d.controlwords[static_cast<uint8_t>(Cia402Goal::Halt)][s] = controlwords.disable_voltage;
+    }
+
+    const Cia402Goal walks[] = {Cia402Goal::Enable, Cia402Goal::Halt};
+    for (const Cia402Goal goal : walks) {
+        const uint16_t halt = goal == Cia402Goal::Halt ? controlwords.halt : 0;
+        uint16_t* cw = d.controlwords[static_cast<uint8_t>(goal)];
+        cw[static_cast<uint8_t>(S::Fault)] = controlwords.fault_reset;
+        cw[static_cast<uint8_t>(S::SwitchOnDisabled)] = controlwords.shutdown;
+        cw[static_cast<uint8_t>(S::ReadyToSwitchOn)] = controlwords.switch_on;
+        cw[static_cast<uint8_t>(S::SwitchedOn)] = static_cast<uint16_t>(controlwords.enable_operation | halt);
+        cw[static_cast<uint8_t>(S::OperationEnabled)] = static_cast<uint16_t>(controlwords.enable_operation | halt);
+    }
+
+    d.reached[static_cast<uint8_t>(Cia402Goal::Enable)] = stateBit(S::OperationEnabled);
+    d.reached[static_cast<uint8_t>(Cia402Goal::Disable)] =
+        stateBit(S::SwitchOnDisabled) | stateBit(S::Fault) | stateBit(S::NotReadyToSwitchOn);
+    d.reached[static_cast<uint8_t>(Cia402Goal::QuickStop)] =
+        stateBit(S::QuickStopActive) | stateBit(S::SwitchOnDisabled) | stateBit(S::Fault) | stateBit(S::NotReadyToSwitchOn);
+    d.reached[static_cast<uint8_t>(Cia402Goal::Halt)] = stateBit(S::OperationEnabled);
+
+    // Fault reaction and not-ready are the drive's own transitions: nothing to retry.
+    d.timeouts[static_cast<uint8_t>(S::Fault)] = fault_reset_timeout;
+    d.timeouts[static_cast<uint8_t>(S::SwitchOnDisabled)] = transition_timeout;
+    d.timeouts[static_cast<uint8_t>(S::ReadyToSwitchOn)] = transition_timeout;
+    d.timeouts[static_cast<uint8_t>(S::SwitchedOn)] = transition_timeout;
+    d.timeouts[static_cast<uint8_t>(S::OperationEnabled)] = transition_timeout;
+    d.timeouts[static_cast<uint8_t>(S::QuickStopActive)] = transition_timeout;
+
+    d.retry = controlwords.disable_voltage;
+    return d;
+}
+
+/** Plain CiA402 controlwords and statusword patterns, for plug-in drivers without a descriptor of their own. */
+inline constexpr cia402_descriptor_t CIA402_STANDARD = cia402Descriptor(
+    cia402_controlwords_t{0x0006, 0x0007, 0x000F, 0x0000, 0x0002, 0x0080, 0x0100, 0x0100},
+    state_pattern_t{0x004F, 0x0040},
+    100,
+    1000);
+
+/** Selects instead of branching, so decoding many axes in a row stays free of mispredictions. */
+constexpr DriverState decode(const cia402_descriptor_t& descriptor, uint16_t statusword)
+{
+    uint8_t state = static_cast<uint8_t>(DriverState::NotReadyToSwitchOn);
+    for (uint8_t s = 0; s < NUMBER_OF_DRIVER_STATES; ++s) {
+        const state_pattern_t& p = descriptor.patterns[s];
+        state = (statusword & p.mask) == p.value ? s : state;
+    }
+    return static_cast<DriverState>(state);
+}
+
+/**
+ * One cycle of `axis` toward `goal`: decodes `statusword`, sets the `controlword` to write and returns `true` once
+ * the goal is reached. The controlword follows the decoded state, not a remembered one, so each transition goes out
+ * the cycle after the drive reports the previous one; a state that outlasts its timeout sends `retry` once.
+ */
+inline bool step(
+    const cia402_descriptor_t& descriptor,
+    Cia402Goal goal,
+    uint16_t statusword,
+    cia402_axis_t& axis,
+    uint16_t& controlword)
+{
+    const DriverState state = decode(descriptor, statusword);
+    const uint8_t s = static_cast<uint8_t>(state);
+    const uint8_t g = static_cast<uint8_t>(goal);
+    axis.cycles = state == axis.state ? static_cast<uint16_t>(axis.cycles + 1) : 0;
+    axis.state = state;
+    controlword = descriptor.controlwords[g][s];
+    if (descriptor.reached[g] & (1u << s)) return true;
+
+    if (descriptor.timeouts[s] != 0 && axis.cycles >= descriptor.timeouts[s]) {
+        axis.cycles = 0;
+        axis.timeouts++;
+        controlword = descriptor.retry;
+    }
+    return false;
+}
+
+} // namespace motor_interface
+#endif // MOTOR_INTERFACE_CIA402_HPP_
@@ -1,14 +1,26 @@
 #ifndef MOTOR_INTERFACE_MOTOR_CONTROLLER_HPP_
 #define MOTOR_INTERFACE_MOTOR_CONTROLLER_HPP_
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "common_motor_interface/motor_frame.hpp"
 #include "motor_interface/motor_master.hpp"
 #include "motor_interface/motor_driver.hpp"
+#include "motor_interface/pdo_plan.hpp"
+#include "motor_interface/sdo_request.hpp"
+#include "motor_interface/unit_converter.hpp"
 
 namespace motor_interface {
 
+/**
+ * `motor_frame_t::controller_index` is 8-bit. Axes 0-254 report their index there; later axes report this value
+ * instead of a wrapped index. Frames are indexed by position, so the field is informational.
+ */
+inline constexpr uint8_t FRAME_INDEX_NONE = 0xFF;
+
 struct slave_config_t {
-    uint8_t controller_index;
+    uint16_t controller_index;
     uint8_t master_id;
     uint8_t driver_id;
     uint16_t alias{};
@@ -21,6 +33,7 @@ class MotorController {
 public:
     explicit MotorController(const slave_config_t& config)
     : index_(config.controller_index)
+    , frame_index_(config.controller_index < FRAME_INDEX_NONE ? static_cast<uint8_t>(config.controller_index) : FRAME_INDEX_NONE)
     , master_id_(config.master_id)
     , driver_id_(config.driver_id) {}
 
@@ -38,22 +51,149 @@ public:
 
     virtual void read(motor_frame_t& status) = 0;
 
+    /** Cyclic: starts `request` on this slave's SDO channel; `false` when there is none or it is busy. Never blocks. */
+    virtual bool startSdo(const sdo_request_t& request) { (void)request; return false; }
+
+    /** Cyclic: state of the transfer started by `startSdo()`; on `Done` a read's data is in `value`. */
+    virtual SdoState pollSdo(uint32_t& value) { (void)value; return SdoState::Failed; }
+
+    /** Batched path: decodes statusword / errorcode into `status` and raw counts into `lanes` slot `index()`; the caller converts lanes to SI. */
+    void readCounts(motor_frame_t& status, axis_lanes_t& lanes)
+    {
+        readData(tx_values_);
+        status.statusword = static_cast<uint16_t>(tx_values_[ID_STATUSWORD]);
+        status.errorcode = static_cast<uint16_t>(tx_values_[ID_ERRORCODE]);
+        status.controller_index = frame_index_;
+        lanes.position_count[index_] = tx_values_[ID_CURRENT_POSITION];
+        lanes.velocity_count[index_] = tx_values_[ID_CURRENT_VELOCITY];
+        lanes.torque_count[index_] = static_cast<int16_t>(tx_values_[ID_CURRENT_TORQUE]);
+    }
+
+    /** Batched path: writes `command` with targets already converted to counts in `lanes` slot `index()`. */
+    void writeCounts(const motor_frame_t& command, const axis_lanes_t& lanes)
+    {
+        rx_values_[ID_CONTROLWORD] = command.controlword;
+        rx_values_[ID_TARGET_POSITION] = lanes.position_count[index_];
+        rx_values_[ID_TARGET_VELOCITY] = lanes.velocity_count[index_];
+        rx_values_[ID_TARGET_TORQUE] = lanes.torque_count[index_];
+        store(rx_values_, requested(command));
+    }
+
+    /** Writes only the controlword (e.g. set-point handshake resolved outside `check()`). */
+    void writeControlword(uint16_t controlword)
+    {
+        rx_values_[ID_CONTROLWORD] = controlword;
+        store(rx_values_, static_cast<uint16_t>(1u << ID_CONTROLWORD));
+    }
+
+    /** Writes modes of operation (0x6060); no-op when the slave does not map it. */
+    void writeMode(int8_t mode)
+    {
+        rx_values_[ID_MODE_OF_OPERATION] = mode;
+        store(rx_values_, static_cast<uint16_t>(1u << ID_MODE_OF_OPERATION));
+    }
+
+    /** Modes of operation display (0x6061) as of the last `readCounts()`; `0` when not mapped. */
+    int8_t modeDisplay() const { return static_cast<int8_t>(tx_values_[ID_MODE_OF_OPERATION_DISPLAY]); }
+
+    /** Controlword last stored into the process image, by any write path (`0` before the first). */
+    uint16_t controlword() const { return controlword_; }
+
+    /** Bit `id` is set for every interface id this slave maps, RX and TX. */
+    uint16_t mapped() const { return static_cast<uint16_t>(rx_mask_ | tx_mask_); }
+
+    uint16_t index() const { return index_; }
+
     uint8_t master_id() const { return master_id_; }
 
     uint8_t driver_id() const { return driver_id_; }
 
+    /** Set by `initialize()`. */
+    const MotorDriver* driver() const { return driver_; }
+
+    /** Command interface ids ignored by `write()` / `writeCounts()` because they are not controlword or target ids. */
+    uint32_t invalid_interface_count() const { return invalid_interfaces_; }
+
 protected:
     virtual void registerEntries() = 0;
 
-    virtual void writeData(const entry_table_t* rx_interfaces, uint8_t number_of_rx_interfaces) = 0;
-
-    virtual void readData(entry_table_t* tx_interfaces, uint8_t number_of_tx_interfaces) = 0;
+    /** Stores `values[id]` into the process image for every id set in `mask` (`rx_plan_`, plus per-domain plans). */
+    virtual void writeData(const int32_t* values, uint16_t mask) = 0;
+
+    /** `writeData()` for every write path, so `controlword()` tracks what the slave actually receives. */
+    void store(const int32_t* values, uint16_t mask)
+    {
+        writeData(values, mask);
+        if (mask & (1u << ID_CONTROLWORD)) controlword_ = static_cast<uint16_t>(values[ID_CONTROLWORD]);
+    }
+
+    /** Loads every `tx_plan_` entry from the process image into `values[id]`. */
+    virtual void readData(int32_t* values) = 0;
+
+    /** Mask of RX ids listed in `command.target_interface_id` that this slave maps. Unknown ids are skipped and counted. */
+    uint16_t requested(const motor_frame_t& command)
+    {
+        uint16_t mask{0};
+        const uint8_t n = std::min(command.number_of_target_interfaces, MAX_INTERFACE_SIZE);
+        for (uint8_t i = 0; i < n; ++i) {
+            const uint8_t id = command.target_interface_id[i];
+            if (id > ID_TARGET_TORQUE) {
+                invalid_interfaces_++;
+                continue;
+            }
+            mask |= static_cast<uint16_t>(1u << id);
+        }
+        return mask & rx_mask_;
+    }
+
+    /** Scales `command` into `values` and returns the mask of requested RX ids. */
+    uint16_t encode(const motor_frame_t& command, int32_t* values)
+    {
+        values[ID_CONTROLWORD] = command.controlword;
+        values[ID_TARGET_POSITION] = driver_->position(command.position);
+        values[ID_TARGET_VELOCITY] = driver_->velocity(command.velocity);
+        values[ID_TARGET_TORQUE] = driver_->torque(command.torque);
+        return requested(command);
+    }
+
+    /** De-scales TX `values` into `status`. */
+    void decode(const int32_t* values, motor_frame_t& status) const
+    {
+        status.statusword = static_cast<uint16_t>(values[ID_STATUSWORD]);
+        status.errorcode = static_cast<uint16_t>(values[ID_ERRORCODE]);
+        status.position = driver_->position(values[ID_CURRENT_POSITION]);
+        status.velocity = driver_->velocity(values[ID_CURRENT_VELOCITY]);
+        status.torque = driver_->torque(static_cast<int16_t>(values[ID_CURRENT_TORQUE]));
+        status.controller_index = frame_index_;
+    }
 
     MotorDriver* driver_{nullptr};
 
-    DriverState current_driver_state_{DriverState::Fault};
+    PdoPlan rx_plan_;
+
+    PdoPlan tx_plan_;
+
+    /** RX ids mapped by this slave over all domains; set by `registerEntries()`. */
+    uint16_t rx_mask_{0};
+
+    /** TX ids mapped by this slave over all domains; set by `registerEntries()`. */
+    uint16_t tx_mask_{0};
+
+    int32_t rx_values_[NUMBER_OF_INTERFACE_IDS]{};
+
+    int32_t tx_values_[NUMBER_OF_INTERFACE_IDS]{};
+
+    /** CiA402 engine state of `enable()` / `disable()`. */
+    cia402_axis_t cia402_{};
+
+    uint32_t invalid_interfaces_{0};
+
+    uint16_t controlword_{0};
+
+    const uint16_t index_;
 
-    const uint8_t index_;
+    /** `index_` when it fits `motor_frame_t::controller_index`, else `FRAME_INDEX_NONE`. */
+    const uint8_t frame_index_;
 
     const uint8_t master_id_;
 
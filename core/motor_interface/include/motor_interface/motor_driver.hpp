@@ -1,6 +1,7 @@
 #ifndef MOTOR_INTERFACE_MOTOR_DRIVER_HPP_
 #define MOTOR_INTERFACE_MOTOR_DRIVER_HPP_
 
+#include <algorithm>
 #include <string>
 #include <cstdint>
 #include <cstddef>
@@ -8,6 +9,8 @@
 #include <type_traits>
 
 #include "common_motor_interface/motor_frame.hpp"
+#include "motor_interface/cia402.hpp"
+#include "motor_interface/unit_converter.hpp"
 
 namespace motor_interface {
 
@@ -23,6 +26,14 @@ inline constexpr uint8_t ID_ERRORCODE        = 5;
 inline constexpr uint8_t ID_CURRENT_POSITION = 6;
 inline constexpr uint8_t ID_CURRENT_VELOCITY = 7;
 inline constexpr uint8_t ID_CURRENT_TORQUE   = 8;
+inline constexpr uint8_t ID_MODE_OF_OPERATION         = 9;
+inline constexpr uint8_t ID_MODE_OF_OPERATION_DISPLAY = 10;
+
+/** Ids the master writes (RX PDO); every other id is read (TX PDO). */
+constexpr bool isRx(uint8_t id)
+{
+    return id <= ID_TARGET_TORQUE || id == ID_MODE_OF_OPERATION;
+}
 
 enum class DataType {
     U8,
@@ -34,14 +45,6 @@ enum class DataType {
     S32
 };
 
-enum class DriverState {
-    Fault,
-    SwitchOnDisabled,
-    ReadyToSwitchOn,
-    SwitchedOn,
-    OperationEnabled
-};
-
 struct driver_config_t {
     uint8_t id;
     uint32_t pulse_per_revolution;
@@ -67,6 +70,16 @@ struct entry_table_t {
     uint8_t data[MAX_DATA_SIZE];
 };
 
+/** Resolved `items` / `interfaces` of a driver as built by `loadParameters()`; trivially copyable. */
+struct driver_tables_t {
+    entry_table_t items[MAX_ITEM_SIZE];
+    entry_table_t interfaces[MAX_INTERFACE_SIZE];
+    uint8_t number_of_items;
+    uint8_t number_of_interfaces;
+    uint8_t number_of_rx_interfaces;
+    uint8_t number_of_tx_interfaces;
+};
+
 inline DataType toDataType(const std::string& type) {
     if (type == "u8") return DataType::U8;
     if (type == "u16") return DataType::U16;
@@ -101,16 +114,32 @@ inline void fill(const T& value, uint8_t* data) {
 
 class MotorDriver {
 public:
-    explicit MotorDriver(const driver_config_t& config)
-    : config_(config) {}
+    explicit MotorDriver(const driver_config_t& config, const cia402_descriptor_t& cia402 = CIA402_STANDARD)
+    : config_(config)
+    , cia402_(cia402) {}
 
     virtual ~MotorDriver() = default;
 
     virtual void loadParameters(const std::string& param_file) = 0;
 
-    virtual bool isEnabled(const uint8_t* data, DriverState& driver_state, uint8_t* out) = 0;
+    /** One CiA402 step toward `goal` from the statusword in `data`; writes the next controlword to `out` while it returns `false`. */
+    bool transition(Cia402Goal goal, const uint8_t* data, cia402_axis_t& axis, uint8_t* out) const
+    {
+        uint16_t controlword{0};
+        if (step(cia402_, goal, value<uint16_t>(data), axis, controlword)) return true;
+        fill<uint16_t>(controlword, out);
+        return false;
+    }
+
+    bool isEnabled(const uint8_t* data, cia402_axis_t& axis, uint8_t* out) const
+    {
+        return transition(Cia402Goal::Enable, data, axis, out);
+    }
 
-    virtual bool isDisabled(const uint8_t* data, DriverState& driver_state, uint8_t* out) = 0;
+    bool isDisabled(const uint8_t* data, cia402_axis_t& axis, uint8_t* out) const
+    {
+        return transition(Cia402Goal::Disable, data, axis, out);
+    }
 
     virtual bool isReceived(const uint8_t* data, uint8_t* out) = 0;
 
@@ -126,6 +155,33 @@ public:
 
     virtual int16_t torque(const double value) = 0;
 
+    /** Per-count SI factors matching `position` / `velocity` / `torque`, for batched conversion. */
+    virtual axis_scale_t scale() const = 0;
+
+    /** Copy of the tables built by `loadParameters()`, e.g. for a compiled configuration image. */
+    driver_tables_t tables() const
+    {
+        driver_tables_t tables{};
+        std::copy(items_, items_ + MAX_ITEM_SIZE, tables.items);
+        std::copy(interfaces_, interfaces_ + MAX_INTERFACE_SIZE, tables.interfaces);
+        tables.number_of_items = number_of_items_;
+        tables.number_of_interfaces = number_of_interfaces_;
+        tables.number_of_rx_interfaces = number_of_rx_interfaces_;
+        tables.number_of_tx_interfaces = number_of_tx_interfaces_;
+        return tables;
+    }
+
+    /** Restores tables saved by `tables()` in place of `loadParameters()`. */
+    void loadTables(const driver_tables_t& tables)
+    {
+        std::copy(tables.items, tables.items + MAX_ITEM_SIZE, items_);
+        std::copy(tables.interfaces, tables.interfaces + MAX_INTERFACE_SIZE, interfaces_);
+        number_of_items_ = tables.number_of_items;
+        number_of_interfaces_ = tables.number_of_interfaces;
+        number_of_rx_interfaces_ = tables.number_of_rx_interfaces;
+        number_of_tx_interfaces_ = tables.number_of_tx_interfaces;
+    }
+
     const entry_table_t* items() const { return items_; }
 
     const entry_table_t* interfaces() const { return interfaces_; }
@@ -138,10 +194,13 @@ public:
 
     uint8_t number_of_tx_interfaces() const { return number_of_tx_interfaces_; }
 
+    /** Vendor transition table used by `transition()`. */
+    const cia402_descriptor_t& cia402() const { return cia402_; }
+
 protected:
-    entry_table_t items_[MAX_ITEM_SIZE];
+    entry_table_t items_[MAX_ITEM_SIZE]{};
 
-    entry_table_t interfaces_[MAX_INTERFACE_SIZE];
+    entry_table_t interfaces_[MAX_INTERFACE_SIZE]{};
 
     uint8_t number_of_items_{0};
 
@@ -152,6 +211,8 @@ protected:
     uint8_t number_of_tx_interfaces_{0};
 
     const driver_config_t config_;
+
+    const cia402_descriptor_t cia402_;
 };
 
 } // namespace motor_interface
@@ -7,17 +7,49 @@
 
 namespace motor_interface {
 
+inline constexpr uint8_t MAX_DOMAIN_SIZE = 4;
+
+/** `schedule()` mask exchanging every domain. */
+inline constexpr uint8_t ALL_DOMAINS = 0xFF;
+
+/** Process data of the last `receive()`, from the domain working counter. */
+enum class DataState : uint8_t {
+    Complete,
+    Incomplete,
+    Zero
+};
+
+/** One process-data domain, exchanged every `divider`-th cycle. */
+struct domain_config_t {
+    uint32_t divider{1};
+
+    /** Bit `id` set for every interface id carried by this domain; domain 0 also carries every id no other domain lists. */
+    uint16_t interfaces{0};
+};
+
 struct master_config_t {
     uint8_t id;
-    uint8_t number_of_slaves;
+    uint16_t number_of_slaves;
     unsigned int master_index{};
+    double time_constant{};
+    double clock_drift{};
+    uint32_t bus_error_after{};
+    uint32_t bus_error_cycles{};
+    uint32_t frame_loss_after{};
+    uint32_t frame_loss_cycles{};
+    domain_config_t domains[MAX_DOMAIN_SIZE]{};
+    uint8_t number_of_domains{1};
 };
 
 class MotorMaster {
 public:
     explicit MotorMaster(const master_config_t& config)
     : id_(config.id)
-    , number_of_slaves_(config.number_of_slaves) {}
+    , number_of_slaves_(config.number_of_slaves)
+    , number_of_domains_(config.number_of_domains)
+    {
+        for (uint8_t d = 0; d < MAX_DOMAIN_SIZE; ++d) domains_[d] = config.domains[d];
+    }
 
     virtual ~MotorMaster() = default;
 
@@ -27,22 +59,57 @@ public:
 
     virtual void deactivate() = 0;
 
-    virtual void transmit() = 0;
+    /** Cyclic: `0` on success, a negative error code otherwise; never throws. */
+    virtual int transmit() = 0;
 
-    virtual void receive() = 0;
+    /** Cyclic: `0` on success, a negative error code otherwise; never throws. */
+    virtual int receive() = 0;
 
     virtual void apply_application_time(const timespec& time) = 0;
 
     virtual void save_clock() = 0;
 
+    /** Working-counter state of the last successful `receive()`; cheap enough to query every cycle. */
+    virtual DataState data_state() const { return DataState::Complete; }
+
+    /** Link state, refreshed by `receive()` at a lower rate than the cycle. */
+    virtual bool link_up() const { return true; }
+
+    /** Lower 32 bits of the DC reference clock latched by the last `save_clock()` round trip; `false` when unavailable. */
+    virtual bool reference_clock_time(uint32_t& time) { (void)time; return false; }
+
+    /** Domains the next `transmit()` queues (bit `d` = domain `d`); set by the scheduler once per cycle. */
+    void schedule(uint8_t domains) { scheduled_ = domains; }
+
+    uint8_t scheduled() const { return scheduled_; }
+
+    /** Domain carrying interface `id`. */
+    uint8_t domainOf(uint8_t id) const
+    {
+        for (uint8_t d = 1; d < number_of_domains_; ++d) {
+            if (domains_[d].interfaces & (1u << id)) return d;
+        }
+        return 0;
+    }
+
+    uint32_t divider(uint8_t domain) const { return domains_[domain].divider; }
+
+    uint8_t number_of_domains() const { return number_of_domains_; }
+
     uint8_t id() const { return id_; }
 
-    uint8_t number_of_slaves() const { return number_of_slaves_; }
+    uint16_t number_of_slaves() const { return number_of_slaves_; }
 
 protected:
     const uint8_t id_;
 
-    uint8_t number_of_slaves_;
+    uint16_t number_of_slaves_;
+
+    domain_config_t domains_[MAX_DOMAIN_SIZE];
+
+    const uint8_t number_of_domains_;
+
+    uint8_t scheduled_{ALL_DOMAINS};
 };
 
 } // namespace motor_interface
@@ -0,0 +1,156 @@
+#ifndef MOTOR_INTERFACE_PDO_PLAN_HPP_
+#define MOTOR_INTERFACE_PDO_PLAN_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include <endian.h>
+
+#include "motor_interface/motor_driver.hpp"
+
+namespace motor_interface {
+
+/** Semantic interface ids `ID_CONTROLWORD` … `ID_MODE_OF_OPERATION_DISPLAY` index `values` arrays of this size. */
+inline constexpr uint8_t NUMBER_OF_INTERFACE_IDS = 11;
+
+inline constexpr uint32_t UNMAPPED_OFFSET = 0xFFFFFFFF;
+
+struct pdo_access_t {
+    uint32_t offset;
+    uint32_t sign_bit;
+    uint8_t id;
+};
+
+/**
+ * Flat, typed access plan over a process image, compiled once per slave.
+ * Entries are grouped by width so `load()` / `store()` are straight loops of direct little-endian
+ * loads/stores; signed entries are sign-extended with a xor/sub on `sign_bit` instead of a branch.
+ * Values are exchanged as `int32_t` indexed by interface id (64-bit entries keep their low 32 bits).
+ */
+class PdoPlan {
+public:
+    PdoPlan() { clear(); }
+
+    void clear()
+    {
+        for (uint8_t i = 0; i <= NUMBER_OF_WIDTHS; ++i) begin_[i] = 0;
+        for (uint8_t i = 0; i < NUMBER_OF_INTERFACE_IDS; ++i) offsets_[i] = UNMAPPED_OFFSET;
+        mask_ = 0;
+    }
+
+    /** Configuration time only; throws on ids outside the semantic range or duplicate ids. */
+    void add(uint8_t id, uint32_t offset, DataType type)
+    {
+        if (id >= NUMBER_OF_INTERFACE_IDS) throw std::runtime_error("Invalid interface ID.");
+        if (mask_ & (1u << id)) throw std::runtime_error("Duplicate interface ID.");
+        if (begin_[NUMBER_OF_WIDTHS] >= MAX_INTERFACE_SIZE) throw std::runtime_error("Too many interfaces.");
+
+        const uint8_t width = widthOf(type);
+        for (uint8_t i = begin_[NUMBER_OF_WIDTHS]; i > begin_[width + 1]; --i) {
+            entries_[i] = entries_[i - 1];
+        }
+        entries_[begin_[width + 1]] = pdo_access_t{offset, signBitOf(type), id};
+        for (uint8_t w = width + 1; w <= NUMBER_OF_WIDTHS; ++w) begin_[w]++;
+
+        offsets_[id] = offset;
+        mask_ |= static_cast<uint16_t>(1u << id);
+    }
+
+    void load(const uint8_t* pd, int32_t* values) const
+    {
+        for (uint8_t i = begin_[0]; i < begin_[1]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            const uint32_t u = pd[e.offset];
+            values[e.id] = static_cast<int32_t>((u ^ e.sign_bit) - e.sign_bit);
+        }
+        for (uint8_t i = begin_[1]; i < begin_[2]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            uint16_t raw;
+            std::memcpy(&raw, pd + e.offset, sizeof(raw));
+            const uint32_t u = le16toh(raw);
+            values[e.id] = static_cast<int32_t>((u ^ e.sign_bit) - e.sign_bit);
+        }
+        for (uint8_t i = begin_[2]; i < begin_[3]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            uint32_t raw;
+            std::memcpy(&raw, pd + e.offset, sizeof(raw));
+            values[e.id] = static_cast<int32_t>(le32toh(raw));
+        }
+        for (uint8_t i = begin_[3]; i < begin_[4]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            uint64_t raw;
+            std::memcpy(&raw, pd + e.offset, sizeof(raw));
+            values[e.id] = static_cast<int32_t>(le64toh(raw));
+        }
+    }
+
+    /** Stores `values[id]` for every planned id whose bit is set in `mask`. */
+    void store(uint8_t* pd, const int32_t* values, uint16_t mask) const
+    {
+        for (uint8_t i = begin_[0]; i < begin_[1]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            if (mask & (1u << e.id)) pd[e.offset] = static_cast<uint8_t>(values[e.id]);
+        }
+        for (uint8_t i = begin_[1]; i < begin_[2]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            if (!(mask & (1u << e.id))) continue;
+            const uint16_t raw = htole16(static_cast<uint16_t>(values[e.id]));
+            std::memcpy(pd + e.offset, &raw, sizeof(raw));
+        }
+        for (uint8_t i = begin_[2]; i < begin_[3]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            if (!(mask & (1u << e.id))) continue;
+            const uint32_t raw = htole32(static_cast<uint32_t>(values[e.id]));
+            std::memcpy(pd + e.offset, &raw, sizeof(raw));
+        }
+        for (uint8_t i = begin_[3]; i < begin_[4]; ++i) {
+            const pdo_access_t& e = entries_[i];
+            if (!(mask & (1u << e.id))) continue;
+            const uint64_t raw = htole64(static_cast<uint64_t>(static_cast<int64_t>(values[e.id])));
+            std::memcpy(pd + e.offset, &raw, sizeof(raw));
+        }
+    }
+
+    /** Bit `id` is set for every planned id. */
+    uint16_t mask() const { return mask_; }
+
+    uint32_t offset(uint8_t id) const { return offsets_[id]; }
+
+    uint8_t size() const { return begin_[NUMBER_OF_WIDTHS]; }
+
+private:
+    static constexpr uint8_t NUMBER_OF_WIDTHS = 4;
+
+    static uint8_t widthOf(DataType type)
+    {
+        switch (type) {
+        case DataType::U8:
+        case DataType::S8: return 0;
+        case DataType::U16:
+        case DataType::S16: return 1;
+        case DataType::U32:
+        case DataType::S32: return 2;
+        case DataType::U64: return 3;
+        }
+        throw std::runtime_error("Invalid interface data type.");
+    }
+
+    static uint32_t signBitOf(DataType type)
+    {
+        if (type == DataType::S8) return 0x80;
+        if (type == DataType::S16) return 0x8000;
+        return 0;
+    }
+
+    pdo_access_t entries_[MAX_INTERFACE_SIZE];
+
+    uint8_t begin_[NUMBER_OF_WIDTHS + 1];
+
+    uint32_t offsets_[NUMBER_OF_INTERFACE_IDS];
+
+    uint16_t mask_{0};
+};
+
+} // namespace motor_interface
+#endif // MOTOR_INTERFACE_PDO_PLAN_HPP_
@@ -0,0 +1,29 @@
+#ifndef MOTOR_INTERFACE_SDO_REQUEST_HPP_
+#define MOTOR_INTERFACE_SDO_REQUEST_HPP_
+
+#include <cstdint>
+
+namespace motor_interface {
+
+enum class SdoState : uint8_t {
+    Busy,
+    Done,
+    Failed
+};
+
+/** One runtime CoE object access on a single slave. */
+struct sdo_request_t {
+    uint16_t index;
+    uint8_t subindex;
+
+    /** Object size in bytes (`1`, `2` or `4`); writes only, reads take the size the slave reports. */
+    uint8_t size;
+
+    bool write;
+
+    /** Little-endian value to write; unused for reads. */
+    uint32_t value;
+};
+
+} // namespace motor_interface
+#endif // MOTOR_INTERFACE_SDO_REQUEST_HPP_
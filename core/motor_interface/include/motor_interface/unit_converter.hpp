@@ -0,0 +1,132 @@
+#ifndef MOTOR_INTERFACE_UNIT_CONVERTER_HPP_
+#define MOTOR_INTERFACE_UNIT_CONVERTER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace motor_interface {
+
+/** Lanes are padded to a multiple of this so every conversion loop runs on full vector blocks. */
+inline constexpr std::size_t LANE_BLOCK = 8;
+
+inline std::size_t paddedLanes(std::size_t n)
+{
+    return (n + LANE_BLOCK - 1) / LANE_BLOCK * LANE_BLOCK;
+}
+
+/** SI units per raw count: rad/count, rad/s per count/s, Nm per torque unit. */
+struct axis_scale_t {
+    double position{};
+
+    double velocity{};
+
+    double torque{};
+};
+
+/** Structure-of-arrays staging for all axes, indexed by controller index. */
+struct axis_lanes_t {
+    std::vector<int32_t> position_count;
+
+    std::vector<int32_t> velocity_count;
+
+    std::vector<int32_t> torque_count;
+
+    std::vector<double> position;
+
+    std::vector<double> velocity;
+
+    std::vector<double> torque;
+
+    void resize(std::size_t n)
+    {
+        const std::size_t lanes = paddedLanes(n);
+        position_count.assign(lanes, 0);
+        velocity_count.assign(lanes, 0);
+        torque_count.assign(lanes, 0);
+        position.assign(lanes, 0.0);
+        velocity.assign(lanes, 0.0);
+        torque.assign(lanes, 0.0);
+    }
+};
+
+/**
+ * Per-axis scale factors held as SoA so raw counts ↔ SI for every axis is one pass of
+ * fixed-width blocks the compiler turns into packed converts and multiplies.
+ * `resize()` / `configure()` run at startup; `toSI()` / `toCounts()` never allocate.
+ */
+class UnitConverter {
+public:
+    void resize(std::size_t n)
+    {
+        const std::size_t lanes = paddedLanes(n);
+        position_scale_.assign(lanes, 0.0);
+        velocity_scale_.assign(lanes, 0.0);
+        torque_scale_.assign(lanes, 0.0);
+        position_inverse_.assign(lanes, 0.0);
+        velocity_inverse_.assign(lanes, 0.0);
+        torque_inverse_.assign(lanes, 0.0);
+    }
+
+    void configure(std::size_t axis, const axis_scale_t& scale)
+    {
+        position_scale_.at(axis) = scale.position;
+        velocity_scale_.at(axis) = scale.velocity;
+        torque_scale_.at(axis) = scale.torque;
+        position_inverse_.at(axis) = scale.position != 0.0 ? 1.0 / scale.position : 0.0;
+        velocity_inverse_.at(axis) = scale.velocity != 0.0 ? 1.0 / scale.velocity : 0.0;
+        torque_inverse_.at(axis) = scale.torque != 0.0 ? 1.0 / scale.torque : 0.0;
+    }
+
+    /** `*_count` → SI for the first `n` axes (rounded up to `LANE_BLOCK`). */
+    void toSI(axis_lanes_t& lanes, std::size_t n) const
+    {
+        const std::size_t end = paddedLanes(n);
+        scale(lanes.position_count.data(), position_scale_.data(), lanes.position.data(), end);
+        scale(lanes.velocity_count.data(), velocity_scale_.data(), lanes.velocity.data(), end);
+        scale(lanes.torque_count.data(), torque_scale_.data(), lanes.torque.data(), end);
+    }
+
+    /** SI → `*_count` (truncated toward zero) for the first `n` axes (rounded up to `LANE_BLOCK`). */
+    void toCounts(axis_lanes_t& lanes, std::size_t n) const
+    {
+        const std::size_t end = paddedLanes(n);
+        unscale(lanes.position.data(), position_inverse_.data(), lanes.position_count.data(), end);
+        unscale(lanes.velocity.data(), velocity_inverse_.data(), lanes.velocity_count.data(), end);
+        unscale(lanes.torque.data(), torque_inverse_.data(), lanes.torque_count.data(), end);
+    }
+
+private:
+    static void scale(const int32_t* __restrict in, const double* __restrict k, double* __restrict out, std::size_t end)
+    {
+        for (std::size_t b = 0; b < end; b += LANE_BLOCK) {
+            for (std::size_t j = 0; j < LANE_BLOCK; ++j) {
+                out[b + j] = static_cast<double>(in[b + j]) * k[b + j];
+            }
+        }
+    }
+
+    static void unscale(const double* __restrict in, const double* __restrict k, int32_t* __restrict out, std::size_t end)
+    {
+        for (std::size_t b = 0; b < end; b += LANE_BLOCK) {
+            for (std::size_t j = 0; j < LANE_BLOCK; ++j) {
+                out[b + j] = static_cast<int32_t>(in[b + j] * k[b + j]);
+            }
+        }
+    }
+
+    std::vector<double> position_scale_;
+
+    std::vector<double> velocity_scale_;
+
+    std::vector<double> torque_scale_;
+
+    std::vector<double> position_inverse_;
+
+    std::vector<double> velocity_inverse_;
+
+    std::vector<double> torque_inverse_;
+};
+
+} // namespace motor_interface
+#endif // MOTOR_INTERFACE_UNIT_CONVERTER_HPP_
@@ -19,18 +19,32 @@ inline constexpr uint8_t ID_MAX_DECELERATION     = 58;
 inline constexpr uint8_t ID_RXPDO                = 98;
 inline constexpr uint8_t ID_TXPDO                = 99;
 
-class MinasDriver : public motor_interface::MotorDriver {
+/** Plain CiA402 controlwords; fault reset retried after 100 cycles, other transitions after 1000. */
+inline constexpr motor_interface::cia402_descriptor_t MINAS_CIA402 = motor_interface::cia402Descriptor(
+    motor_interface::cia402_controlwords_t{0x0006, 0x0007, 0x000F, 0x0000, 0x0002, 0x0080, 0x0100, 0x0100},
+    motor_interface::state_pattern_t{0x004F, 0x0040},
+    100,
+    1000);
+
+inline constexpr uint16_t SW_SETPOINT_ACKNOWLEDGE = 0x1000;
+inline constexpr uint16_t CW_SETPOINT_RECEIVED    = 0x000F;
+
+class MinasDriver final : public motor_interface::MotorDriver {
 public:
     explicit MinasDriver(const motor_interface::driver_config_t& config);
 
     void loadParameters(const std::string& param_file) override;
 
-    bool isEnabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out) override;
-
-    bool isDisabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out) override;
-
     bool isReceived(const uint8_t* data, uint8_t* out) override;
 
+    /** Typed, inlinable form of `isReceived` for statically dispatched callers. */
+    bool received(uint16_t statusword, uint16_t& controlword) const
+    {
+        if (!(statusword & SW_SETPOINT_ACKNOWLEDGE)) return false;
+        controlword = CW_SETPOINT_RECEIVED;
+        return true;
+    }
+
     double position(const int32_t value) override;
 
     double velocity(const int32_t value) override;
@@ -42,6 +56,8 @@ public:
     int32_t velocity(const double value) override;
 
     int16_t torque(const double value) override;
+
+    motor_interface::axis_scale_t scale() const override;
 };
 
 } // namespace minas
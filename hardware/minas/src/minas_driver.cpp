@@ -5,49 +5,8 @@
 
 #include "minas/minas_driver.hpp"
 
-namespace {
-
-constexpr uint16_t CW_SHUTDOWN = 0x0006;
-constexpr uint16_t CW_SWITCH_ON = 0x0007;
-constexpr uint16_t CW_ENABLE_OPERATION = 0x000F;
-constexpr uint16_t CW_DISABLE_VOLTAGE = 0x0000;
-constexpr uint16_t CW_DISABLE_OPERATION = 0x0007;
-constexpr uint16_t CW_FAULT_RESET = 0x0080;
-
-bool isFault(uint16_t sw)
-{
-    return (sw & 0x0008) != 0;
-}
-
-bool isReadyToSwitchOn(uint16_t sw)
-{
-    return (sw & 0x006F) == 0x0021;
-}
-
-bool isSwitchedOn(uint16_t sw)
-{
-    return (sw & 0x006F) == 0x0023;
-}
-
-bool isOperationEnabled(uint16_t sw)
-{
-    return (sw & 0x006F) == 0x0027;
-}
-
-bool isSwitchOnDisabled(uint16_t sw)
-{
-    return (sw & 0x004F) == 0x0040;
-}
-
-bool isSetpointAcknowledge(uint16_t sw)
-{
-    return (sw & 0x1000) != 0;
-}
-
-} // namespace
-
 minas::MinasDriver::MinasDriver(const motor_interface::driver_config_t& config)
-    : motor_interface::MotorDriver(config)
+    : motor_interface::MotorDriver(config, MINAS_CIA402)
 {
 }
 
@@ -180,7 +139,7 @@ void minas::MinasDriver::loadParameters(const std::string& param_file)
             e_cfg.size = i["size"].as<uint8_t>();
             e_cfg.type = motor_interface::toDataType(i["type"].as<std::string>());
 
-            if (e_cfg.id <= motor_interface::ID_TARGET_TORQUE) {
+            if (motor_interface::isRx(e_cfg.id)) {
                 r_idx++;
             } else {
                 t_idx++;
@@ -193,84 +152,11 @@ void minas::MinasDriver::loadParameters(const std::string& param_file)
     number_of_tx_interfaces_ = t_idx;
 }
 
-bool minas::MinasDriver::isEnabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out)
-{
-    uint16_t sw = motor_interface::value<uint16_t>(data);
-    uint16_t cw = CW_ENABLE_OPERATION;
-
-    switch (driver_state) {
-    case motor_interface::DriverState::Fault: {
-        cw = CW_FAULT_RESET;
-        if (isSwitchOnDisabled(sw)) driver_state = motor_interface::DriverState::SwitchOnDisabled;
-        break;
-    } case motor_interface::DriverState::SwitchOnDisabled: {
-        cw = CW_SHUTDOWN;
-        if (isReadyToSwitchOn(sw)) driver_state = motor_interface::DriverState::ReadyToSwitchOn;
-        break;
-    } case motor_interface::DriverState::ReadyToSwitchOn: {
-        cw = CW_SWITCH_ON;
-        if (isSwitchedOn(sw)) driver_state = motor_interface::DriverState::SwitchedOn;
-        break;
-    } case motor_interface::DriverState::SwitchedOn: {
-        cw = CW_ENABLE_OPERATION;
-        if (isOperationEnabled(sw)) driver_state = motor_interface::DriverState::OperationEnabled;
-        break;
-    } case motor_interface::DriverState::OperationEnabled: {
-        return true;
-    } default: {
-        throw std::runtime_error("Invalid driver state.");
-    }
-    }
-
-    motor_interface::fill<uint16_t>(cw, out);
-    return false;
-}
-
-bool minas::MinasDriver::isDisabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out)
-{
-    uint16_t sw = motor_interface::value<uint16_t>(data);
-    uint16_t cw = CW_ENABLE_OPERATION;
-
-    /*
-    switch (driver_state) {
-    case motor_interface::DriverState::SwitchOnDisabled: {
-        return true;
-    } case motor_interface::DriverState::ReadyToSwitchOn: {
-        cw = CW_DISABLE_VOLTAGE;
-        if (isSwitchOnDisabled(sw)) driver_state = motor_interface::DriverState::SwitchOnDisabled;
-        break;
-    } case motor_interface::DriverState::SwitchedOn: {
-        cw = CW_SHUTDOWN;
-        if (isReadyToSwitchOn(sw)) driver_state = motor_interface::DriverState::ReadyToSwitchOn;
-        break;
-    } case motor_interface::DriverState::OperationEnabled: {
-        cw = CW_DISABLE_OPERATION;
-        if (isSwitchedOn(sw)) driver_state = motor_interface::DriverState::SwitchedOn;
-        break;
-    } default: {
-        throw std::runtime_error("Invalid driver state.");
-    }
-    }
-    */
-
-    switch (driver_state) {
-    case motor_interface::DriverState::SwitchOnDisabled: {
-        return true;
-    } default: {
-        cw = 0x100;
-        if (isSwitchOnDisabled(sw)) driver_state = motor_interface::DriverState::SwitchOnDisabled;
-    }
-    }
-
-    motor_interface::fill<uint16_t>(cw, out);
-    return false;
-}
-
 bool minas::MinasDriver::isReceived(const uint8_t* data, uint8_t* out)
 {
-    uint16_t sw = motor_interface::value<uint16_t>(data);
-    if (isSetpointAcknowledge(sw)) {
-        motor_interface::fill<uint16_t>(0x0F, out);
+    uint16_t cw{0};
+    if (received(motor_interface::value<uint16_t>(data), cw)) {
+        motor_interface::fill<uint16_t>(cw, out);
         return true;
     }
     return false;
@@ -305,3 +191,13 @@ int16_t minas::MinasDriver::torque(const double value)
 {
     return static_cast<int16_t>(value / config_.rated_torque * 100 / config_.unit_torque);
 }
+
+motor_interface::axis_scale_t minas::MinasDriver::scale() const
+{
+    const double count = (2 * M_PI) / static_cast<double>(config_.pulse_per_revolution);
+    return motor_interface::axis_scale_t{
+        count,
+        count,
+        config_.rated_torque * 0.01 * config_.unit_torque
+    };
+}
@@ -15,18 +15,32 @@ inline constexpr uint8_t ID_PROFILE_DECELERATION = 54;
 inline constexpr uint8_t ID_RXPDO = 98;
 inline constexpr uint8_t ID_TXPDO = 99;
 
-class ZeroerrDriver : public motor_interface::MotorDriver {
+/** Controlwords with "change set immediately" (bit 5) set; switch-on disabled also requires quick stop (bit 5) clear. */
+inline constexpr motor_interface::cia402_descriptor_t ZEROERR_CIA402 = motor_interface::cia402Descriptor(
+    motor_interface::cia402_controlwords_t{0x0026, 0x0027, 0x002F, 0x0000, 0x0002, 0x0080, 0x0100, 0x0100},
+    motor_interface::state_pattern_t{0x006F, 0x0040},
+    100,
+    1000);
+
+inline constexpr uint16_t SW_SETPOINT_ACKNOWLEDGE = 0x1000;
+inline constexpr uint16_t CW_SETPOINT_RECEIVED = 0x000F;
+
+class ZeroerrDriver final : public motor_interface::MotorDriver {
 public:
     explicit ZeroerrDriver(const motor_interface::driver_config_t& config);
 
     void loadParameters(const std::string& param_file) override;
 
-    bool isEnabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out) override;
-
-    bool isDisabled(const uint8_t* data, motor_interface::DriverState& driver_state, uint8_t* out) override;
-
     bool isReceived(const uint8_t* data, uint8_t* out) override;
 
+    /** Typed, inlinable form of `isReceived` for statically dispatched callers. */
+    bool received(uint16_t statusword, uint16_t& controlword) const
+    {
+        if (!(statusword & SW_SETPOINT_ACKNOWLEDGE)) return false;
+        controlword = CW_SETPOINT_RECEIVED;
+        return true;
+    }
+
     double position(const int32_t value) override;
 
     double velocity(const int32_t value) override;
@@ -38,6 +52,8 @@ public:
     int32_t velocity(const double value) override;
 
     int16_t torque(const double value) override;
+
+    motor_interface::axis_scale_t scale() const override;
 };
 
 } // namespace zeroerr
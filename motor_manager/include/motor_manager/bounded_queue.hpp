@@ -0,0 +1,91 @@
+#ifndef MOTOR_MANAGER_BOUNDED_QUEUE_HPP_
+#define MOTOR_MANAGER_BOUNDED_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "motor_manager/triple_buffer.hpp"
+
+namespace motor_manager {
+
+/**
+ * Lock-free bounded multi-producer / multi-consumer FIFO of trivially copyable `T` (per-cell sequence numbers).
+ * `push()` / `pop()` never block or allocate; they return `false` when the queue is full / empty.
+ * `N` must be a power of two.
+ */
+template <typename T, std::size_t N>
+class BoundedQueue {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "BoundedQueue capacity must be a power of two.");
+
+public:
+    BoundedQueue()
+    {
+        for (std::size_t i = 0; i < N; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool push(const T& value)
+    {
+        std::size_t position = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell_t& cell = cells_[position & MASK];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(T& value)
+    {
+        std::size_t position = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            cell_t& cell = cells_[position & MASK];
+            const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference =
+                static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0) {
+                if (head_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + N, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+private:
+    static constexpr std::size_t MASK = N - 1;
+
+    struct cell_t {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    cell_t cells_[N];
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_BOUNDED_QUEUE_HPP_
@@ -0,0 +1,33 @@
+#ifndef MOTOR_MANAGER_CAPACITY_HPP_
+#define MOTOR_MANAGER_CAPACITY_HPP_
+
+#include <cstdint>
+
+// Ceilings of one configuration, set by the CMake cache variables of the same name. They bound the compiled
+// configuration image and the id types; per-axis storage is sized to the configured counts once at startup.
+// Above 255 axes, the 8-bit motor_frame_t::controller_index cannot name every axis: axes from 255 on report
+// motor_interface::FRAME_INDEX_NONE there. Frames are indexed by position everywhere, so nothing relies on it.
+#ifndef MOTOR_MANAGER_MAX_MASTERS
+#define MOTOR_MANAGER_MAX_MASTERS 8
+#endif
+
+#ifndef MOTOR_MANAGER_MAX_DRIVERS
+#define MOTOR_MANAGER_MAX_DRIVERS 8
+#endif
+
+#ifndef MOTOR_MANAGER_MAX_CONTROLLERS
+#define MOTOR_MANAGER_MAX_CONTROLLERS 1024
+#endif
+
+namespace motor_manager {
+
+inline constexpr uint8_t MAX_MASTER_SIZE = MOTOR_MANAGER_MAX_MASTERS;
+inline constexpr uint8_t MAX_DRIVER_SIZE = MOTOR_MANAGER_MAX_DRIVERS;
+inline constexpr uint16_t MAX_CONTROLLER_SIZE = MOTOR_MANAGER_MAX_CONTROLLERS;
+
+static_assert(MOTOR_MANAGER_MAX_MASTERS >= 1 && MOTOR_MANAGER_MAX_MASTERS <= 255, "MOTOR_MANAGER_MAX_MASTERS must be 1-255.");
+static_assert(MOTOR_MANAGER_MAX_DRIVERS >= 1 && MOTOR_MANAGER_MAX_DRIVERS <= 255, "MOTOR_MANAGER_MAX_DRIVERS must be 1-255.");
+static_assert(MOTOR_MANAGER_MAX_CONTROLLERS >= 1 && MOTOR_MANAGER_MAX_CONTROLLERS <= 65535, "MOTOR_MANAGER_MAX_CONTROLLERS must be 1-65535.");
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_CAPACITY_HPP_
@@ -0,0 +1,148 @@
+#ifndef MOTOR_MANAGER_CONFIG_IMAGE_HPP_
+#define MOTOR_MANAGER_CONFIG_IMAGE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "motor_interface/motor_master.hpp"
+#include "motor_interface/motor_driver.hpp"
+#include "motor_interface/motor_controller.hpp"
+#include "motor_manager/motor_manager.hpp"
+
+namespace motor_manager {
+
+/** "MMCI" in file order. */
+inline constexpr uint32_t CONFIG_IMAGE_MAGIC = 0x49434D4D;
+
+/** Bump on any layout change of `config_image_t` or of the structs it embeds. */
+inline constexpr uint32_t CONFIG_IMAGE_VERSION = 2;
+
+/** `motor_manager_config` writes the image of `config.yaml` to `config.yaml` + this suffix; `MotorManager` only reads it. */
+inline constexpr const char* CONFIG_IMAGE_SUFFIX = ".cache";
+
+/** Environment variable overriding the directory `MotorManager` writes compiled images to. */
+inline constexpr const char* CONFIG_CACHE_DIR_ENV = "MOTOR_MANAGER_CACHE_DIR";
+
+inline constexpr std::size_t MAX_SOURCE_PATH = 256;
+
+/** The top-level configuration plus one `param_file` per driver. */
+inline constexpr uint8_t MAX_SOURCE_SIZE = 1 + MAX_DRIVER_SIZE;
+
+inline constexpr uint8_t MAX_IMAGE_CPUS = 64;
+
+struct config_image_header_t {
+    uint32_t magic;
+
+    uint32_t version;
+
+    /** `sizeof(config_image_t)` of the writer: rejects images from builds with another layout. */
+    uint32_t size;
+
+    /** FNV-1a 32 over every byte after the header. */
+    uint32_t checksum;
+
+    /** `hashSources()` at compile time; the image is stale once it differs. */
+    uint64_t source_hash;
+};
+
+/** `realtime` block without the `std::vector`. */
+struct image_thread_config_t {
+    int32_t cpus[MAX_IMAGE_CPUS];
+    uint8_t number_of_cpus;
+    SchedulingPolicy policy;
+    int32_t priority;
+    uint64_t runtime;
+    uint64_t deadline;
+};
+
+struct image_master_t {
+    motor_interface::master_config_t config;
+    CommunicationType type;
+
+    /** `-1`: not pinned. */
+    int32_t cpu;
+};
+
+struct image_driver_t {
+    motor_interface::driver_config_t config;
+    DriverType type;
+    motor_interface::driver_tables_t tables;
+};
+
+/**
+ * Everything `MotorManager` reads from YAML, resolved: topology, driver tables and tuning. Plain data so it can be
+ * written as one block and mapped back; only valid for the build (`size`) and format (`version`) that wrote it.
+ */
+struct config_image_t {
+    config_image_header_t header;
+
+    uint32_t period;
+    bool parallel_masters;
+    uint32_t max_consecutive_errors;
+
+    bool clock_sync;
+    uint8_t sync_master_id;
+    bool has_sync_master;
+    double kp;
+    double ki;
+    int64_t max_correction;
+
+    image_thread_config_t realtime;
+
+    image_master_t masters[MAX_MASTER_SIZE];
+    uint8_t number_of_masters;
+
+    motor_interface::slave_config_t slaves[MAX_CONTROLLER_SIZE];
+    uint16_t number_of_slaves;
+
+    image_driver_t drivers[MAX_DRIVER_SIZE];
+    uint8_t number_of_drivers;
+
+    /** Absolute paths of the files the image was compiled from. */
+    char sources[MAX_SOURCE_SIZE][MAX_SOURCE_PATH];
+    uint8_t number_of_sources;
+};
+
+/** Parses `config_file` and every driver `param_file` into `image` (header included); throws like the YAML loader. */
+void compileConfiguration(const std::string& config_file, config_image_t& image);
+
+/** FNV-1a 64 over the source paths and their current contents; `0` when a source cannot be read. */
+uint64_t hashSources(const config_image_t& image);
+
+/** FNV-1a 32 over the bytes after the header. */
+uint32_t checksum(const config_image_t& image);
+
+/**
+ * `<dir>/<hash of the absolute config path>.image`, where `dir` is `$MOTOR_MANAGER_CACHE_DIR`, else
+ * `$XDG_CACHE_HOME/motor_manager`, else `$HOME/.cache/motor_manager`; empty when none of them is set.
+ */
+std::string configCachePath(const std::string& config_file);
+
+/** Writes `image` to `path` through a temporary file and `rename`, creating missing directories; `false` on any I/O failure. */
+bool saveConfigImage(const config_image_t& image, const std::string& path);
+
+/** Read-only mapping of a compiled image; `open()` validates magic, version, size and checksum. */
+class ConfigImageMapping {
+public:
+    ConfigImageMapping() = default;
+
+    ~ConfigImageMapping() { close(); }
+
+    ConfigImageMapping(const ConfigImageMapping&) = delete;
+
+    ConfigImageMapping& operator=(const ConfigImageMapping&) = delete;
+
+    /** `false` when the file is missing, truncated or fails validation. */
+    bool open(const std::string& path);
+
+    void close();
+
+    const config_image_t& image() const { return *image_; }
+
+private:
+    const config_image_t* image_{nullptr};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_CONFIG_IMAGE_HPP_
@@ -0,0 +1,92 @@
+#ifndef MOTOR_MANAGER_CYCLE_BARRIER_HPP_
+#define MOTOR_MANAGER_CYCLE_BARRIER_HPP_
+
+#include <atomic>
+#include <cstdint>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "motor_manager/triple_buffer.hpp"
+
+namespace motor_manager {
+
+/** Default spin rounds before a `CycleBarrier` waiter sleeps on the futex. */
+inline constexpr uint32_t BARRIER_SPIN = 1000;
+
+/**
+ * Reusable barrier for the per-master RT threads. Waiters spin for `spin` rounds (the common case when
+ * all threads wake within a few microseconds of each other), then sleep on a futex. Pass `spin = 0` when the
+ * parties share a CPU: spinning there only delays the thread being waited for. `cancel()` releases
+ * every current and future waiter; `arrive_and_wait()` then returns `false`.
+ */
+class CycleBarrier {
+public:
+    explicit CycleBarrier(uint32_t parties, uint32_t spin = BARRIER_SPIN)
+    : parties_(parties)
+    , spin_(spin) {}
+
+    CycleBarrier(const CycleBarrier&) = delete;
+
+    CycleBarrier& operator=(const CycleBarrier&) = delete;
+
+    bool arrive_and_wait()
+    {
+        if (cancelled_.load(std::memory_order_acquire)) return false;
+
+        const uint32_t generation = generation_.load(std::memory_order_acquire);
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == parties_) {
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.fetch_add(1, std::memory_order_seq_cst);
+            if (sleepers_.load(std::memory_order_seq_cst) > 0) wake();
+            return !cancelled_.load(std::memory_order_acquire);
+        }
+
+        for (uint32_t i = 0; i < spin_; ++i) {
+            if (generation_.load(std::memory_order_acquire) != generation) {
+                return !cancelled_.load(std::memory_order_acquire);
+            }
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        while (generation_.load(std::memory_order_seq_cst) == generation) {
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation_), FUTEX_WAIT_PRIVATE, generation, nullptr, nullptr, 0);
+        }
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        return !cancelled_.load(std::memory_order_acquire);
+    }
+
+    void cancel()
+    {
+        cancelled_.store(true, std::memory_order_release);
+        generation_.fetch_add(1, std::memory_order_seq_cst);
+        wake();
+    }
+
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+
+private:
+    void wake()
+    {
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&generation_), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+    }
+
+    const uint32_t parties_;
+
+    const uint32_t spin_;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> arrived_{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> generation_{0};
+
+    std::atomic<uint32_t> sleepers_{0};
+
+    std::atomic<bool> cancelled_{false};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_CYCLE_BARRIER_HPP_
@@ -0,0 +1,136 @@
+#ifndef MOTOR_MANAGER_CYCLE_STATISTICS_HPP_
+#define MOTOR_MANAGER_CYCLE_STATISTICS_HPP_
+
+#include <cstdint>
+#include <limits>
+
+namespace motor_manager {
+
+enum class CyclePhase : uint8_t {
+    Wakeup,
+    Receive,
+    Update,
+    SaveClock,
+    Transmit,
+    Cycle
+};
+
+inline constexpr uint8_t NUMBER_OF_CYCLE_PHASES = 6;
+
+/**
+ * Fixed-size log-linear latency histogram (HDR style): 16 linear sub-buckets per power of two,
+ * i.e. about 6 % relative resolution from 1 ns up to ~4.3 s. `record()` never allocates.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint8_t SUB_BUCKET_BITS = 4;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+    static constexpr uint8_t MAX_MAGNITUDE = 32;
+    static constexpr uint32_t BUCKET_COUNT = (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+    static constexpr uint64_t MAX_VALUE = (1ULL << MAX_MAGNITUDE) - 1;
+
+    static uint32_t bucketIndex(uint64_t value)
+    {
+        if (value > MAX_VALUE) value = MAX_VALUE;
+        if (value < SUB_BUCKET_COUNT) return static_cast<uint32_t>(value);
+
+        const uint32_t msb = 63u - static_cast<uint32_t>(__builtin_clzll(value));
+        const uint32_t shift = msb - SUB_BUCKET_BITS;
+        return (shift + 1) * SUB_BUCKET_COUNT + static_cast<uint32_t>((value >> shift) - SUB_BUCKET_COUNT);
+    }
+
+    static uint64_t bucketUpperBound(uint32_t index)
+    {
+        if (index < SUB_BUCKET_COUNT) return index;
+
+        const uint32_t shift = index / SUB_BUCKET_COUNT - 1;
+        const uint64_t lower = static_cast<uint64_t>(SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+        return lower + (1ULL << shift) - 1;
+    }
+
+    void record(uint64_t value)
+    {
+        counts_[bucketIndex(value)]++;
+        count_++;
+        sum_ += value;
+        if (value < min_) min_ = value;
+        if (value > max_) max_ = value;
+    }
+
+    void reset() { *this = LatencyHistogram{}; }
+
+    uint64_t count() const { return count_; }
+
+    uint64_t min() const { return count_ ? min_ : 0; }
+
+    uint64_t max() const { return max_; }
+
+    uint64_t mean() const { return count_ ? sum_ / count_ : 0; }
+
+    /** Upper bound of the bucket holding the `percentile` (0-100) sample, clamped to `max()`. */
+    uint64_t percentile(double percentile) const
+    {
+        if (count_ == 0) return 0;
+
+        uint64_t rank = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(count_) + 0.5);
+        if (rank < 1) rank = 1;
+        if (rank > count_) rank = count_;
+
+        uint64_t seen{0};
+        for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                const uint64_t upper = bucketUpperBound(i);
+                return upper < max_ ? upper : max_;
+            }
+        }
+        return max_;
+    }
+
+    const uint64_t* counts() const { return counts_; }
+
+private:
+    uint64_t counts_[BUCKET_COUNT]{};
+
+    uint64_t count_{0};
+
+    uint64_t sum_{0};
+
+    uint64_t min_{std::numeric_limits<uint64_t>::max()};
+
+    uint64_t max_{0};
+};
+
+/** DC drift compensation state (`clock_sync`); all zero when disabled. */
+struct clock_sync_statistics_t {
+    /** Last reference clock − application time (ns). */
+    int32_t offset{0};
+
+    /** Largest `|offset|` since the last reset (ns). */
+    uint32_t max_offset{0};
+
+    /** Last wakeup correction (ns). */
+    int64_t correction{0};
+
+    /** Estimated reference clock drift against `CLOCK_MONOTONIC` (ppm). */
+    double drift_ppm{0.0};
+};
+
+/** Per-phase timings of `MotorManager::run()` in nanoseconds. */
+struct cycle_statistics_t {
+    LatencyHistogram phases[NUMBER_OF_CYCLE_PHASES];
+
+    uint64_t cycles{0};
+
+    /** Cycles whose work finished after the next scheduled wakeup. */
+    uint64_t overruns{0};
+
+    clock_sync_statistics_t clock_sync{};
+
+    const LatencyHistogram& phase(CyclePhase p) const { return phases[static_cast<uint8_t>(p)]; }
+
+    LatencyHistogram& phase(CyclePhase p) { return phases[static_cast<uint8_t>(p)]; }
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_CYCLE_STATISTICS_HPP_
@@ -0,0 +1,69 @@
+#ifndef MOTOR_MANAGER_DRIFT_COMPENSATOR_HPP_
+#define MOTOR_MANAGER_DRIFT_COMPENSATOR_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace motor_manager {
+
+/**
+ * PI loop that syncs the master to the DC reference clock. Each cycle `update()` takes
+ * offset = reference clock − application time and returns the nanoseconds to add to the next
+ * monotonic wakeup; the application time itself keeps advancing by exactly one period, so a
+ * reference clock running fast by d shortens the wakeup interval by `period · d` in steady state.
+ */
+class DriftCompensator {
+public:
+    void configure(uint32_t period, double kp, double ki, int64_t max_correction)
+    {
+        period_ = period;
+        kp_ = kp;
+        ki_ = ki;
+        max_correction_ = static_cast<double>(max_correction);
+        reset();
+    }
+
+    void reset()
+    {
+        integral_ = 0.0;
+        offset_ = 0;
+        correction_ = 0;
+    }
+
+    int64_t update(int32_t offset)
+    {
+        offset_ = offset;
+        integral_ = std::clamp(integral_ + ki_ * offset, -max_correction_, max_correction_);
+        const double output = std::clamp(kp_ * offset + integral_, -max_correction_, max_correction_);
+        correction_ = -std::llround(output);
+        return correction_;
+    }
+
+    /** Last measured reference − application time (ns). */
+    int32_t offset() const { return offset_; }
+
+    /** Last wakeup correction (ns). */
+    int64_t correction() const { return correction_; }
+
+    /** Reference clock rate relative to `CLOCK_MONOTONIC` (ppm), from the integral term. */
+    double drift_ppm() const { return period_ ? integral_ / period_ * 1e6 : 0.0; }
+
+private:
+    uint32_t period_{0};
+
+    double kp_{0.0};
+
+    double ki_{0.0};
+
+    double max_correction_{0.0};
+
+    double integral_{0.0};
+
+    int32_t offset_{0};
+
+    int64_t correction_{0};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_DRIFT_COMPENSATOR_HPP_
@@ -0,0 +1,40 @@
+#ifndef MOTOR_MANAGER_DRIVER_DISPATCH_HPP_
+#define MOTOR_MANAGER_DRIVER_DISPATCH_HPP_
+
+#include <type_traits>
+#include <variant>
+
+#include "motor_manager/motor_manager.hpp"
+#include "minas/minas_driver.hpp"
+#include "zeroerr/zeroerr_driver.hpp"
+
+namespace motor_manager {
+
+/** Resolves a configured driver to its concrete type once, at startup; unknown drivers keep the virtual path. */
+inline driver_handle_t toDriverHandle(motor_interface::MotorDriver* driver)
+{
+    if (auto* d = dynamic_cast<minas::MinasDriver*>(driver)) return d;
+    if (auto* d = dynamic_cast<zeroerr::ZeroerrDriver*>(driver)) return d;
+    return driver;
+}
+
+/** Statically dispatched set-point handshake: inlines the concrete driver's `received()`. */
+inline bool received(const driver_handle_t& driver, uint16_t statusword, uint16_t& controlword)
+{
+    return std::visit([&](auto* d) {
+        using D = std::remove_pointer_t<decltype(d)>;
+        if constexpr (std::is_same_v<D, motor_interface::MotorDriver>) {
+            uint8_t sw_data[2];
+            uint8_t cw_data[2]{0};
+            motor_interface::fill<uint16_t>(statusword, sw_data);
+            if (!d->isReceived(sw_data, cw_data)) return false;
+            controlword = motor_interface::value<uint16_t>(cw_data);
+            return true;
+        } else {
+            return d->received(statusword, controlword);
+        }
+    }, driver);
+}
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_DRIVER_DISPATCH_HPP_
@@ -2,28 +2,55 @@
 #define MOTOR_MANAGER_MOTOR_MANAGER_HPP_
 
 #include <atomic>
+#include <exception>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <variant>
+#include <vector>
 
 #include "motor_interface/motor_master.hpp"
 #include "motor_interface/motor_driver.hpp"
 #include "motor_interface/motor_controller.hpp"
+#include "motor_manager/capacity.hpp"
+#include "motor_manager/triple_buffer.hpp"
+#include "motor_manager/cycle_statistics.hpp"
+#include "motor_manager/cycle_barrier.hpp"
+#include "motor_manager/realtime.hpp"
+#include "motor_manager/drift_compensator.hpp"
+#include "motor_manager/sdo_engine.hpp"
+#include "motor_manager/shared_memory.hpp"
+#include "motor_manager/telemetry.hpp"
+#include "motor_manager/trajectory.hpp"
+
+namespace minas { class MinasDriver; }
+namespace zeroerr { class ZeroerrDriver; }
 
 namespace motor_manager {
 
+/** Concrete driver known at compile time for the cyclic path; `MotorDriver*` is the plug-in fallback. */
+using driver_handle_t = std::variant<minas::MinasDriver*, zeroerr::ZeroerrDriver*, motor_interface::MotorDriver*>;
+
 inline constexpr uint64_t NSEC_PER_SEC = 1000000000;
 
-inline constexpr uint8_t MAX_MASTER_SIZE = 8;
-inline constexpr uint8_t MAX_DRIVER_SIZE = 8;
-inline constexpr uint8_t MAX_CONTROLLER_SIZE = 16;
+/** `master_lookup_` / `driver_lookup_` entry of an id that is not configured. */
+inline constexpr uint8_t UNASSIGNED_SLOT = 0xFF;
+
+/** Default `max_consecutive_errors`: failed cycles a master tolerates before its axes hold their last command. */
+inline constexpr uint32_t DEFAULT_MAX_CONSECUTIVE_ERRORS = 10;
+
+/** Cycles a mode switch waits for the drive's mode display before it adopts the displayed mode. */
+inline constexpr uint16_t MODE_SWITCH_TIMEOUT = 1000;
+
+/** `run()` publishes a statistics snapshot every this many cycles. */
+inline constexpr uint32_t STATISTICS_PUBLISH_CYCLES = 256;
 
 enum class CommunicationType {
     Ethercat,
     Canopen,
-    Dynamixel
+    Dynamixel,
+    Simulation
 };
 
 enum class DriverType {
@@ -36,9 +63,110 @@ inline CommunicationType toCommunicationType(const std::string& type) {
     if (type == "ethercat") return CommunicationType::Ethercat;
     if (type == "canopen") return CommunicationType::Canopen;
     if (type == "dynamixel") return CommunicationType::Dynamixel;
+    if (type == "simulation") return CommunicationType::Simulation;
     throw std::runtime_error("Invalid communication type.");
 }
 
+/** One slot of the command / status exchange: a frame per controller index, sized once at startup. */
+struct frame_block_t {
+    std::vector<motor_interface::motor_frame_t> frames;
+
+    /** Status only: the frame comes from a complete working counter this cycle; otherwise it repeats the last valid one. */
+    std::vector<uint8_t> valid;
+
+    /** Status only: mode of operation the drive displays (the commanded one when it does not map 0x6061). */
+    std::vector<int8_t> modes;
+
+    void resize(std::size_t n)
+    {
+        frames.assign(n, motor_interface::motor_frame_t{});
+        valid.assign(n, 0);
+        modes.assign(n, 0);
+    }
+};
+
+/** Sparse command: `frame` for axis `index` (the 8-bit `frame.controller_index` is ignored, see `capacity.hpp`). */
+struct axis_command_t {
+    uint16_t index;
+
+    motor_interface::motor_frame_t frame;
+};
+
+/** Fault containment state of one axis, maintained by `update()`. */
+enum class AxisState : uint8_t {
+    Healthy,
+
+    /** Reported a non-zero `errorcode`: masked out and held until `reset_fault()`. */
+    Faulted,
+
+    /** Walking the CiA402 fault reset and enable sequence again after `reset_fault()`. */
+    Resetting,
+
+    /** Waiting for the drive to display the mode requested by `set_mode()`: held like a faulted axis, not counted as one. */
+    Switching,
+
+    /** Quick-stopped or halted (`quick_stop()` / `halt()`), or walking back to operation enabled after `resume()`. */
+    Stopped
+};
+
+/** Bus health of one master, maintained by `run()`. */
+struct master_health_t {
+    uint64_t receive_errors{0};
+
+    uint64_t transmit_errors{0};
+
+    /** Cycles in a row with a failed `receive()` or `transmit()`; reset by the first clean cycle. */
+    uint32_t consecutive_errors{0};
+
+    /** Last non-zero code returned by `receive()` / `transmit()`. */
+    int last_error{0};
+
+    /** `consecutive_errors` reached `max_consecutive_errors`: this master's axes hold their last command. */
+    bool degraded{false};
+
+    uint64_t degraded_cycles{0};
+
+    /** Cycles whose working counter was not complete (incomplete or zero). */
+    uint64_t wkc_mismatches{0};
+
+    /** Subset of `wkc_mismatches` where only part of the slaves processed the datagrams. */
+    uint64_t incomplete_domains{0};
+
+    uint64_t link_down_events{0};
+
+    bool link_up{true};
+};
+
+struct bus_health_t {
+    master_health_t masters[MAX_MASTER_SIZE];
+
+    uint8_t number_of_masters{0};
+
+    /** Command interface ids ignored because they are not RX ids, over all controllers. */
+    uint64_t invalid_interfaces{0};
+
+    /** Axes currently faulted or resetting. */
+    uint16_t faulted_axes{0};
+
+    /** Axes currently `AxisState::Stopped`. */
+    uint16_t stopped_axes{0};
+
+    /** Faults latched and resets completed since startup. */
+    uint64_t axis_faults{0};
+
+    uint64_t fault_resets{0};
+
+    /** Mode switches the drive confirmed, and those that timed out and adopted the displayed mode instead. */
+    uint64_t mode_switches{0};
+
+    uint64_t mode_timeouts{0};
+
+    /** Quick stops and halts started, and resumes completed. */
+    uint64_t axis_stops{0};
+
+    uint64_t axis_resumes{0};
+};
+
 inline DriverType toDriverType(const std::string& type) {
     if (type == "minas") return DriverType::Minas;
     if (type == "zeroerr") return DriverType::Zeroerr;
@@ -46,6 +174,8 @@ inline DriverType toDriverType(const std::string& type) {
     throw std::runtime_error("Invalid driver type.");
 }
 
+struct config_image_t;
+
 class MotorManager {
 public:
     explicit MotorManager(const std::string& config_file);
@@ -54,49 +184,308 @@ public:
 
     void run();
 
-    void write(const motor_interface::motor_frame_t* command, const uint8_t size);
+    /** Activates / deactivates the masters (activation primes every axis' mode of operation); `run()` does this itself, offline `step()` callers do it around their loop. */
+    void start()
+    {
+        cycle_ = 0;
+        correction_ = 0;
+        drift_.reset();
+        for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->activate();
+        for (uint16_t i = 0; i < number_of_controllers_; ++i) controllers_[i]->writeMode(modes_[i]);
+    }
+
+    void stop() { for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->deactivate(); }
+
+    /**
+     * One serial cycle at `application_time` (ns) on the calling thread, without `run()`'s clock, RT scheduling or
+     * memory locking: for replay and regression runs. `false` once a `request_stop()` has disabled every axis.
+     * With `clock_sync` it runs the drift compensator too; the caller adds `correction()` to its next wakeup and
+     * passes that wakeup as `monotonic_time` (ns), against which waypoints are sampled. `0` takes `application_time`,
+     * which is the same clock without `clock_sync`.
+     */
+    bool step(uint64_t application_time, uint64_t monotonic_time = 0);
+
+    /** `clock_sync`: wakeup correction (ns) computed by the last cycle; `0` without it. */
+    int64_t correction() const { return correction_; }
+
+    void write(const motor_interface::motor_frame_t* command, const uint16_t size);
+
+    /**
+     * Sparse form: commands only the listed axes (invalid indices are skipped). Either form copies and flags only
+     * the axes whose command differs from the pending one; `run()` re-encodes and writes just those.
+     */
+    void write(const axis_command_t* commands, uint16_t size);
+
+    /**
+     * Queues a chunk of timestamped waypoints for axis `controller_index`; `run()` interpolates between them every
+     * cycle and writes the target position. Lock-free; returns how many were queued (fewer when the queue is full).
+     */
+    uint8_t write(uint16_t controller_index, const waypoint_t* waypoints, uint8_t size);
 
     void read(motor_interface::motor_frame_t* status);
 
+    /** As `read(status)`; `valid[i]` is `false` when axis `i` repeats stale data (working counter not complete). */
+    void read(motor_interface::motor_frame_t* status, bool* valid);
+
+    /**
+     * Re-runs the CiA402 fault reset and enable sequence on axis `index` if it is faulted; lock-free. Commands
+     * written while the axis was faulted go out once it is enabled again. `false` when `index` is invalid.
+     */
+    bool reset_fault(uint16_t index);
+
+    /**
+     * Quick stop on axis `index` from its next cycle with valid data; lock-free. The drive decelerates on its quick
+     * stop ramp and the axis is held like a faulted axis, its commands kept flagged, until `resume()`. Requests on a
+     * faulted, resetting or mode-switching axis wait until it is healthy again. `false` when `index` is invalid.
+     */
+    bool quick_stop(uint16_t index);
+
+    /** As `quick_stop()`, but sets the halt bit: the drive stops on its halt ramp and stays in operation enabled. */
+    bool halt(uint16_t index);
+
+    /**
+     * Walks a quick-stopped or halted axis back to operation enabled from its measured state; lock-free. Its flagged
+     * commands go out once it is enabled. A no-op on axes that are not stopped; `false` when `index` is invalid.
+     */
+    bool resume(uint16_t index);
+
+    /**
+     * Switches axis `index` to `mode` (CSP / CSV / CST) from its next cycle, without re-activating the master; lock-free.
+     * The axis holds its measured state until the drive displays the mode. `false` when `index` is invalid or the
+     * axis does not map modes of operation.
+     */
+    bool set_mode(uint16_t index, motor_interface::OperationMode mode);
+
+    /**
+     * Sets `mode` to the raw 0x6061 value axis `index` last displayed (the commanded mode for drives that do not map
+     * 0x6061); safe to call from any non-RT thread. It is `0` until the first cycle publishes a status, and may be `0`
+     * or non-cyclic while a drive has not reported a mode yet (`isCyclicMode()`). `false` when `index` is invalid.
+     */
+    bool mode(uint16_t index, int8_t& mode);
+
     /** `user_command` / Empty: start CiA402 disable until all axes report disabled, then `run()` returns. */
     void request_stop();
 
     /** Node teardown: clear the RT loop flag so `run()` exits (after current sleep slice); does not wait for drive disable. */
     void request_exit();
 
+    /** Latest per-phase timing snapshot published by `run()` (by `step()` too, without phase timings); safe to call from any non-RT thread. */
+    cycle_statistics_t statistics();
+
+    /** Latest per-master error counters and degraded flags published by `run()`; safe to call from any non-RT thread. */
+    bus_health_t health();
+
+    /** Async SDO read of `index:subindex` on axis `controller_index`; any non-RT thread. `run()` serves it between cyclic exchanges. */
+    std::future<sdo_result_t> read_sdo(uint16_t controller_index, uint16_t index, uint8_t subindex);
+
+    /** Async SDO write of a `size`-byte (1, 2 or 4) object. */
+    std::future<sdo_result_t> write_sdo(uint16_t controller_index, uint16_t index, uint8_t subindex, uint8_t size, uint32_t value);
+
+    /** Callback form of `read_sdo` / `write_sdo`: `callback` runs on the SDO completion thread; `false` when invalid or the queue is full. */
+    bool submit_sdo(uint16_t controller_index, const motor_interface::sdo_request_t& request, sdo_callback_t callback);
+
+    /** Records every axis, every cycle, to the binary log `path` (see `telemetry.hpp`); throws when already recording or the file cannot be created. */
+    void start_recording(const std::string& path);
+
+    /** Flushes and closes the log; no-op when not recording. Callers serialize `start_recording` / `stop_recording`. */
+    void stop_recording() { telemetry_.stop(); }
+
+    /**
+     * Exposes commands and status in the POSIX shared-memory segment `name` (see `shared_memory.hpp`) for
+     * `SharedMemoryClient`s in other processes. Call before `run()` / `start()`; throws when it cannot be created.
+     */
+    void open_shared_memory(const std::string& name) { shm_.open(name, period_, number_of_controllers_); }
+
+    /** Removes the segment; call while `run()` is not running. No-op when none is open. */
+    void close_shared_memory() { shm_.close(); }
+
+    /** Samples written and dropped by the current (or last) recording. */
+    telemetry_statistics_t telemetry() const { return telemetry_.statistics(); }
+
+    /** Asks `run()` to clear its histograms at the start of the next cycle. */
+    void reset_statistics() { statistics_reset_.store(true, std::memory_order_release); }
+
+    /** Placement of the `run()` thread (and the master threads in parallel mode); `run()` prints it at startup. */
+    std::string placement_report() const;
+
     uint32_t period() const { return period_; }
 
-    uint8_t number_of_controllers() const { return number_of_controllers_; }
+    uint16_t number_of_controllers() const { return number_of_controllers_; }
+
+    /** Controller of axis `index` (`< number_of_controllers()`), e.g. to reach a simulated slave in a replay. */
+    motor_interface::MotorController& controller(uint16_t index) { return *controllers_[index]; }
+
+    /** The configuration came from a compiled image instead of being parsed. */
+    bool loaded_from_cache() const { return loaded_from_cache_; }
 
 private:
+    /**
+     * Maps `config_file` + `CONFIG_IMAGE_SUFFIX`, else `configCachePath(config_file)`, when valid and its sources are
+     * unchanged; otherwise compiles the YAML and rewrites the image in the cache directory, never next to the YAML.
+     */
     void loadConfigurations(const std::string& config_file);
 
+    /** Constructs masters, controllers and drivers from a resolved image; validates ids, capacities and indices. */
+    void build(const config_image_t& image);
+
+    /** Sizes every per-axis buffer to `number_of_controllers_`; nothing in the cyclic path allocates afterwards. */
     void initialize();
 
-    void start() { for (auto& m_iter : masters_) m_iter.second->activate(); }
+    /** Configuration time only: slot of master / driver `id`; throws when `id` is not configured. */
+    uint8_t masterSlot(uint8_t id) const;
 
-    void stop() { for (auto& m_iter : masters_) m_iter.second->deactivate(); }
+    uint8_t driverSlot(uint8_t id) const;
 
     void enable();
 
     void disable();
 
+    /** One CiA402 engine pass toward `goal` over the axes of masters with valid data; returns how many have reached it. */
+    uint16_t walk(motor_interface::Cia402Goal goal);
+
+    /** Steps axis `index` toward `goal` on this cycle's statusword and writes the controlword until it is reached. */
+    bool transition(uint16_t index, motor_interface::Cia402Goal goal);
+
+    /** As `transition()`, but keeps writing the goal's controlword once reached (the halt bit, the quick stop command). */
+    bool hold(uint16_t index, motor_interface::Cia402Goal goal);
+
+    /** RT: writes the measured position, velocity and torque as the target of axis `index`'s mode (bumpless). */
+    void writeMeasured(uint16_t index);
+
     void check(const motor_interface::motor_frame_t* status);
 
+    /** Under `write_mutex_`: takes the axes shared memory commanded since the last `write()` into `overridden_`. */
+    void claim();
+
+    /**
+     * Under `write_mutex_`: takes `frame` as axis `index`'s pending command and flags it when it changed, or when a
+     * shared-memory command replaced it in the image since.
+     */
+    void stage(uint16_t index, const motor_interface::motor_frame_t& frame);
+
+    /** Under `write_mutex_`: patches the back slot with every axis it is missing, publishes it, then hands the flags to the RT loop. */
+    void commit();
+
+    /** RT: converts and writes `rt_commands_` of the axes flagged in `rt_dirty_`; axes of degraded masters or not healthy stay flagged. */
+    void apply();
+
+    /** RT: latches axes reporting a fault, starts requested resets and advances running ones and mode switches; publishes health on change. */
+    void contain();
+
+    /** RT: starts the mode switches `set_mode()` requested on healthy axes; requests on other axes wait. */
+    void switchModes();
+
+    /** RT: starts the stops and resumes requested on healthy or stopped axes; requests on other axes wait. */
+    void stopAxes();
+
     void update();
 
-    std::unordered_map<uint8_t, std::unique_ptr<motor_interface::MotorMaster>> masters_;
+    /** Enable / disable / `update()`, then the SDO engine and telemetry of `cycle`; `false` once every axis is disabled after `request_stop()`. */
+    bool control(uint64_t cycle);
+
+    /** Samples the active trajectories at `monotonic_time_` and writes their set-points; after `update()`'s command path. */
+    void follow();
+
+    /** While recording: queues one `telemetry_sample_t` per axis for `cycle`; never blocks. */
+    void capture(uint64_t cycle);
+
+    /** Accounts this cycle's receive and last cycle's transmit results into `rt_health_`; publishes on change. */
+    void monitor();
+
+    /** Multi-rate scheduler: hands every master the domains due in `cycle` (`cycle % divider == 0`) for its next `transmit()`. */
+    void schedule(uint64_t cycle);
 
-    std::unordered_map<uint8_t, std::unique_ptr<motor_interface::MotorDriver>> drivers_;
+    /** `clock_sync`: PI step on the reference master's DC clock against the previous application time. */
+    int64_t synchronize(uint64_t previous_application_time);
 
-    std::unique_ptr<motor_interface::MotorController> controllers_[MAX_CONTROLLER_SIZE];
+    void record(
+        const timespec& wakeup,
+        const timespec& woken,
+        const timespec& received,
+        const timespec& updated,
+        const timespec& saved,
+        const timespec& transmitted);
+
+    /** Per-master RT thread of the parallel mode: receive / (update on the main thread) / transmit, phase-aligned on `barrier`. */
+    void runMaster(
+        uint8_t m_slot,
+        const thread_config_t& config,
+        CycleBarrier& barrier,
+        std::exception_ptr& error);
+
+    /** `rt_config_`, pinned to the master's `cpu` when one is configured. */
+    thread_config_t masterThreadConfig(uint8_t m_slot) const;
+
+    /** Dense slots `0 … number_of_masters_ - 1` in configuration order; ids are resolved through `master_lookup_` at load. */
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<motor_interface::MotorMaster> masters_[MAX_MASTER_SIZE];
+
+    /** Optional CPU each master's RT thread is pinned to in parallel mode (`-1`: not pinned), by master slot. */
+    int master_cpus_[MAX_MASTER_SIZE];
+
+    alignas(CACHE_LINE_SIZE) std::unique_ptr<motor_interface::MotorDriver> drivers_[MAX_DRIVER_SIZE];
+
+    uint8_t master_lookup_[256];
+
+    uint8_t driver_lookup_[256];
+
+    uint8_t number_of_masters_{0};
+
+    uint8_t number_of_drivers_{0};
+
+    /** By controller index; every per-axis vector below has `number_of_controllers_` entries from `initialize()` on. */
+    std::vector<std::unique_ptr<motor_interface::MotorController>> controllers_;
+
+    /** Controller indices grouped by master slot; master `m` owns `controller_order_[master_begin_[m] … master_begin_[m + 1])`. */
+    std::vector<uint16_t> controller_order_;
+
+    uint16_t master_begin_[MAX_MASTER_SIZE + 1];
+
+    /** Master slot of each controller index. */
+    std::vector<uint8_t> controller_master_;
+
+    std::vector<driver_handle_t> dispatch_;
 
     uint32_t period_{0};
 
-    uint8_t number_of_controllers_{0};
+    uint16_t number_of_controllers_{0};
 
     uint32_t frequency_{0};
 
+    /** `realtime` block: placement of the `run()` thread, inherited by the master threads. */
+    thread_config_t rt_config_{};
+
+    /** `parallel_masters`: one SCHED_FIFO thread per master instead of walking `masters_` serially. */
+    bool parallel_masters_{false};
+
+    /** Application time of the current cycle (ns); with `clock_sync` it drifts from `CLOCK_MONOTONIC`. */
+    uint64_t cycle_time_{0};
+
+    /** `CLOCK_MONOTONIC` wakeup of the current cycle (ns); waypoint times are sampled against it. */
+    uint64_t monotonic_time_{0};
+
+    /** Cycles since the last `start()`; feeds the multi-rate scheduler and telemetry. */
+    uint64_t cycle_{0};
+
+    /** Application time of the current cycle, handed to the master threads across the cycle barrier. */
+    timespec cycle_application_time_{};
+
+    /** `clock_sync` block present: the wakeup schedule follows `sync_master_`'s DC reference clock. */
+    bool clock_sync_{false};
+
+    uint8_t sync_master_{0};
+
+    DriftCompensator drift_;
+
+    int64_t correction_{0};
+
+    SdoEngine sdo_;
+
+    TelemetryRecorder telemetry_;
+
+    SharedMemoryServer shm_;
+
+    bool loaded_from_cache_{false};
+
     bool is_enable_{false};
 
     bool is_disabled_{false};
@@ -105,13 +494,131 @@ private:
 
     std::atomic<bool> running_{true};
 
-    std::mutex frame_mutex_;
+    /** Serializes client `write()` callers; never taken by the RT loop. */
+    std::mutex write_mutex_;
+
+    /** Serializes client `read()` callers; never taken by the RT loop. */
+    std::mutex read_mutex_;
+
+    frame_block_t pending_command_{};
+
+    /** Client side, one bit per axis and 64 axes per word: axes staged by the current `write()`. */
+    std::vector<uint64_t> staged_;
+
+    /** Client side: axes whose image no longer holds `pending_command_`, because a shared-memory command replaced it. */
+    std::vector<uint64_t> overridden_;
+
+    /** Client side: axes whose frame in command slot `s` is older than `pending_command_`. */
+    std::vector<uint64_t> stale_[TripleBuffer<frame_block_t>::SIZE];
+
+    TripleBuffer<frame_block_t> command_;
+
+    /** Axes with a published command the RT loop has not taken yet; `commit()` ORs in after publishing. */
+    std::unique_ptr<std::atomic<uint64_t>[]> dirty_;
+
+    /** RT only: taken from `dirty_` and `shm_`, cleared as the axes are written. */
+    std::vector<uint64_t> rt_dirty_;
+
+    /** RT only: axes `dirty_` flagged this cycle, before they join `rt_dirty_`. */
+    std::vector<uint64_t> rt_fresh_;
+
+    /** Axes the RT loop took a shared-memory command for; `claim()` moves them into `overridden_`. */
+    std::unique_ptr<std::atomic<uint64_t>[]> foreign_;
+
+    /** RT only: axes `shm_` flagged this cycle. */
+    std::vector<uint64_t> rt_foreign_;
+
+    /** RT only: newest command of each axis from `write()` or shared memory; `apply()` writes the flagged ones. */
+    std::vector<motor_interface::motor_frame_t> rt_commands_;
+
+    std::size_t dirty_words_{0};
+
+    /** Axes `reset_fault()` was called for since the RT loop last looked, same layout as `dirty_`. */
+    std::unique_ptr<std::atomic<uint64_t>[]> reset_requests_;
+
+    /** RT only: by controller index. */
+    std::vector<AxisState> axis_states_;
+
+    /** Latest `Cia402Goal` requested per axis by `quick_stop()` / `halt()` / `resume()` (`Enable`), flagged in `stop_requests_`. */
+    std::unique_ptr<std::atomic<uint8_t>[]> requested_stops_;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> stop_requests_;
+
+    /** RT only: taken from `stop_requests_`, cleared as the requests are applied. */
+    std::vector<uint64_t> rt_stop_requests_;
+
+    /** RT only: goal `AxisState::Stopped` axes are held at; `Enable` while resuming. */
+    std::vector<motor_interface::Cia402Goal> stop_goals_;
+
+    /** Latest mode `set_mode()` requested per axis, flagged in `mode_requests_` (same layout as `dirty_`). */
+    std::unique_ptr<std::atomic<int8_t>[]> requested_modes_;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> mode_requests_;
+
+    /** RT only: taken from `mode_requests_`, cleared as the switches start. */
+    std::vector<uint64_t> rt_mode_requests_;
+
+    /** RT only: commanded and displayed mode of each axis, and cycles spent in `AxisState::Switching`. */
+    std::vector<int8_t> modes_;
+
+    std::vector<int8_t> displayed_modes_;
+
+    std::vector<uint16_t> mode_cycles_;
+
+    /** The axis maps modes of operation display (0x6061); otherwise the commanded mode counts as displayed. */
+    std::vector<uint8_t> displays_mode_;
+
+    /** Target interface written when an axis switches mode: the new mode's target, set to the measured value. */
+    motor_interface::motor_frame_t switch_frame_{};
+
+    /** Transition table of each axis' driver, resolved once in `initialize()`. */
+    std::vector<const motor_interface::cia402_descriptor_t*> cia402_;
+
+    /** RT only: engine state of each axis for `walk()` and fault resets. */
+    std::vector<motor_interface::cia402_axis_t> cia402_axes_;
+
+    TripleBuffer<frame_block_t> status_;
+
+    std::vector<motor_interface::motor_frame_t> rt_status_;
+
+    /** Not movable (lock-free queues), hence an array allocated in `initialize()`. */
+    std::unique_ptr<TrajectoryFollower[]> trajectories_;
+
+    /** `follow()`: the axis sampled a set-point this cycle. */
+    std::vector<uint8_t> following_;
+
+    /** Target interfaces written for an axis following a trajectory: the target position only. */
+    motor_interface::motor_frame_t trajectory_frame_{};
+
+    motor_interface::UnitConverter converter_;
+
+    motor_interface::axis_lanes_t status_lanes_;
+
+    motor_interface::axis_lanes_t command_lanes_;
+
+    uint32_t max_consecutive_errors_{DEFAULT_MAX_CONSECUTIVE_ERRORS};
+
+    /** Return codes of the masters' last `receive()` / `transmit()`, by master slot. */
+    int receive_results_[MAX_MASTER_SIZE]{};
+
+    int transmit_results_[MAX_MASTER_SIZE]{};
+
+    /** This cycle's process data of the master is complete; `update()` only reads and handshakes valid masters. */
+    bool data_valid_[MAX_MASTER_SIZE]{};
+
+    bus_health_t rt_health_{};
+
+    std::mutex health_mutex_;
+
+    TripleBuffer<bus_health_t> health_;
+
+    std::mutex statistics_mutex_;
 
-    std::atomic<bool> is_command_changed_{false};
+    std::atomic<bool> statistics_reset_{false};
 
-    motor_interface::motor_frame_t command_[MAX_CONTROLLER_SIZE];
+    cycle_statistics_t rt_statistics_{};
 
-    motor_interface::motor_frame_t status_[MAX_CONTROLLER_SIZE];
+    TripleBuffer<cycle_statistics_t> statistics_;
 };
 
 } // namespace motor_manager
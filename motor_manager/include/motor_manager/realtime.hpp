@@ -0,0 +1,69 @@
+#ifndef MOTOR_MANAGER_REALTIME_HPP_
+#define MOTOR_MANAGER_REALTIME_HPP_
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace motor_manager {
+
+inline constexpr const char* ISOLATED_CPUS_PATH = "/sys/devices/system/cpu/isolated";
+inline constexpr const char* NOHZ_FULL_CPUS_PATH = "/sys/devices/system/cpu/nohz_full";
+
+enum class SchedulingPolicy {
+    Fifo,
+    RoundRobin,
+    Deadline
+};
+
+inline SchedulingPolicy toSchedulingPolicy(const std::string& policy) {
+    if (policy == "fifo") return SchedulingPolicy::Fifo;
+    if (policy == "rr") return SchedulingPolicy::RoundRobin;
+    if (policy == "deadline") return SchedulingPolicy::Deadline;
+    throw std::runtime_error("Invalid scheduling policy.");
+}
+
+inline const char* toString(SchedulingPolicy policy) {
+    switch (policy) {
+    case SchedulingPolicy::Fifo: return "fifo";
+    case SchedulingPolicy::RoundRobin: return "rr";
+    case SchedulingPolicy::Deadline: return "deadline";
+    }
+    return "unknown";
+}
+
+/** Placement of one RT thread (`realtime` YAML block). */
+struct thread_config_t {
+    /** CPUs the thread may run on; empty keeps the inherited affinity. */
+    std::vector<int> cpus;
+
+    SchedulingPolicy policy{SchedulingPolicy::Fifo};
+
+    /** FIFO / RR priority; `0` selects `sched_get_priority_max(policy)`. */
+    int priority{0};
+
+    /** DEADLINE budget per period in ns; `0` selects half of `period`. */
+    uint64_t runtime{0};
+
+    /** DEADLINE relative deadline in ns; `0` selects `period`. */
+    uint64_t deadline{0};
+
+    /** Cycle period in ns (the manager's `period`). */
+    uint64_t period{0};
+};
+
+/** Applies `config` (affinity first, then policy) to the calling thread; throws on failure. */
+void applyThreadConfig(const thread_config_t& config);
+
+/** Parses a kernel CPU list such as `"1,4-6"`; throws on malformed input. */
+std::vector<int> parseCpuList(const std::string& list);
+
+/** CPU list stored in a sysfs file; empty when the file is missing or empty. */
+std::vector<int> readCpuList(const char* path);
+
+/** One report line for thread `name`, warning about CPUs outside `isolcpus` / `nohz_full`. */
+std::string placementReport(const std::string& name, const thread_config_t& config);
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_REALTIME_HPP_
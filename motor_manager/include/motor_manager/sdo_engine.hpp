@@ -0,0 +1,115 @@
+#ifndef MOTOR_MANAGER_SDO_ENGINE_HPP_
+#define MOTOR_MANAGER_SDO_ENGINE_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "motor_interface/motor_controller.hpp"
+#include "motor_interface/sdo_request.hpp"
+#include "motor_manager/bounded_queue.hpp"
+
+namespace motor_manager {
+
+/** Transfers in flight or queued at once, over all axes. */
+inline constexpr uint8_t SDO_POOL_SIZE = 64;
+
+/** Controller calls (`startSdo` / `pollSdo`) `SdoEngine::process()` makes per cycle at most. */
+inline constexpr uint8_t SDO_BUDGET = 4;
+
+/** Sleep of the completion thread while it has nothing to deliver (ms). */
+inline constexpr uint32_t SDO_COMPLETION_POLL = 1;
+
+/** Outcome of one transfer: `error` is `0` or a negative errno (`-EIO` aborted by the slave, `-EAGAIN` pool full, …). */
+struct sdo_result_t {
+    int error;
+
+    /** Data of a successful read. */
+    uint32_t value;
+};
+
+using sdo_callback_t = std::function<void(const sdo_result_t&)>;
+
+/**
+ * Runtime SDO traffic next to the cyclic exchange. Non-RT threads `submit()` into a lock-free queue; the RT loop
+ * calls `process()` once per cycle, which starts and polls transfers on the controllers' SDO channels (one per slave)
+ * with at most `SDO_BUDGET` controller calls. Finished transfers go to a completion thread that fulfils the future
+ * or runs the callback, so the RT loop never touches promises, callbacks or the allocator.
+ */
+class SdoEngine {
+public:
+    SdoEngine();
+
+    ~SdoEngine();
+
+    SdoEngine(const SdoEngine&) = delete;
+
+    SdoEngine& operator=(const SdoEngine&) = delete;
+
+    /** Startup only, before the RT loop: one SDO channel per axis. */
+    void resize(uint16_t number_of_controllers) { in_flight_.assign(number_of_controllers, NO_SLOT); }
+
+    /** Any non-RT thread. Errors (full pool, invalid write size) come back through the future. */
+    std::future<sdo_result_t> submit(uint16_t controller_index, const motor_interface::sdo_request_t& request);
+
+    /** As `submit()`; `callback` runs on the completion thread. `false` (callback not called) when the pool is full. */
+    bool submit(uint16_t controller_index, const motor_interface::sdo_request_t& request, sdo_callback_t callback);
+
+    /** RT, once per cycle: polls in-flight transfers, then starts queued ones on idle channels; bounded work. */
+    void process(std::unique_ptr<motor_interface::MotorController>* controllers, uint16_t number_of_controllers);
+
+    /** After the RT loop stopped: fails every queued and in-flight transfer with `-ECANCELED`. */
+    void cancel();
+
+private:
+    static constexpr uint8_t NO_SLOT = 0xFF;
+
+    /** Channel still busy with a cancelled transfer; polled until idle, nothing is delivered. */
+    static constexpr uint8_t ORPHANED_SLOT = 0xFE;
+
+    struct sdo_slot_t {
+        uint16_t controller_index{0};
+        motor_interface::sdo_request_t request{};
+        sdo_result_t result{};
+        std::promise<sdo_result_t> promise;
+        sdo_callback_t callback;
+    };
+
+    /** `0xFF` when the pool is full. */
+    uint8_t acquire(uint16_t controller_index, const motor_interface::sdo_request_t& request);
+
+    void complete(uint8_t slot, int error, uint32_t value = 0);
+
+    void deliver(uint8_t slot);
+
+    void runCompletion();
+
+    sdo_slot_t slots_[SDO_POOL_SIZE];
+
+    BoundedQueue<uint8_t, SDO_POOL_SIZE> free_;
+
+    BoundedQueue<uint8_t, SDO_POOL_SIZE> submitted_;
+
+    BoundedQueue<uint8_t, SDO_POOL_SIZE> completed_;
+
+    /** RT only: slot running on each controller's channel; sized by `resize()`. */
+    std::vector<uint8_t> in_flight_;
+
+    /** RT only: FIFO of submitted slots waiting for their channel. */
+    uint8_t backlog_[SDO_POOL_SIZE];
+
+    uint8_t backlog_size_{0};
+
+    uint16_t poll_cursor_{0};
+
+    std::atomic<bool> stop_{false};
+
+    std::thread completion_;
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_SDO_ENGINE_HPP_
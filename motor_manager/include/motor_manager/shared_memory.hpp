@@ -0,0 +1,176 @@
+#ifndef MOTOR_MANAGER_SHARED_MEMORY_HPP_
+#define MOTOR_MANAGER_SHARED_MEMORY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "common_motor_interface/motor_frame.hpp"
+#include "motor_manager/triple_buffer.hpp"
+
+namespace motor_manager {
+
+/** "MMSH" in memory order. */
+inline constexpr uint32_t SHM_MAGIC = 0x48534D4D;
+
+inline constexpr uint32_t SHM_VERSION = 1;
+
+/** Start of a segment, written once by `SharedMemoryServer::open()`; the offsets are from the segment start. */
+struct shm_header_t {
+    uint32_t magic;
+
+    uint32_t version;
+
+    /** Cycle period (ns). */
+    uint32_t period;
+
+    uint16_t number_of_controllers;
+
+    /** `sizeof(shm_axis_status_t)` / `sizeof(shm_command_t)` of the server. */
+    uint16_t status_size;
+
+    uint16_t command_size;
+
+    uint16_t reserved[3];
+
+    /** `std::atomic<uint64_t>` words, one bit per axis: commands posted and not yet taken by the RT loop. */
+    uint64_t pending_offset;
+
+    /** `shm_status_t`, followed by one `shm_axis_status_t` per axis. */
+    uint64_t status_offset;
+
+    /** One `shm_command_t` per axis. */
+    uint64_t command_offset;
+
+    uint64_t size;
+};
+
+/** Seqlock of the status block: `sequence` is odd while the RT loop rewrites the axes after it. */
+struct alignas(CACHE_LINE_SIZE) shm_status_t {
+    std::atomic<uint64_t> sequence;
+
+    /** `MotorManager` cycle the snapshot was taken in. */
+    uint64_t cycle;
+};
+
+struct shm_axis_status_t {
+    motor_interface::motor_frame_t frame;
+
+    /** The frame comes from a complete working counter this cycle. */
+    uint8_t valid;
+
+    /** Mode of operation the drive displays. */
+    int8_t mode;
+};
+
+/** Command slot of one axis; its one writer is the client that owns the axis. `sequence` is odd while it writes. */
+struct alignas(CACHE_LINE_SIZE) shm_command_t {
+    std::atomic<uint32_t> sequence;
+
+    motor_interface::motor_frame_t frame;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared-memory atomics must be address free.");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "Shared-memory atomics must be address free.");
+
+/**
+ * RT side of the POSIX shared-memory interface: a seqlock-protected status snapshot and per-axis command slots
+ * flagged in a pending bitmask, so out-of-process clients exchange frames without copies through the ROS graph.
+ * `open()` / `close()` run on one non-RT thread while the RT loop is not running; `publish()` / `take()` never block.
+ */
+class SharedMemoryServer {
+public:
+    SharedMemoryServer() = default;
+
+    ~SharedMemoryServer() { close(); }
+
+    SharedMemoryServer(const SharedMemoryServer&) = delete;
+
+    SharedMemoryServer& operator=(const SharedMemoryServer&) = delete;
+
+    /** Creates segment `name` (e.g. `"/motor_manager"`), replacing a stale one; throws when it cannot be created. */
+    void open(const std::string& name, uint32_t period, uint16_t number_of_controllers);
+
+    /** Unmaps and unlinks the segment; mapped clients keep their view until they close. No-op when closed. */
+    void close();
+
+    bool is_open() const { return header_ != nullptr; }
+
+    /** RT: rewrites the status of every axis under the seqlock. */
+    void publish(
+        uint64_t cycle,
+        const motor_interface::motor_frame_t* frames,
+        const uint8_t* valid,
+        const int8_t* modes);
+
+    /**
+     * RT: copies every command posted since the last call into `commands[axis]` and sets its bit in `dirty`
+     * (64 axes per word). A slot caught mid-write is skipped; its client flags it again when done.
+     */
+    void take(motor_interface::motor_frame_t* commands, uint64_t* dirty);
+
+private:
+    std::string name_;
+
+    shm_header_t* header_{nullptr};
+
+    std::atomic<uint64_t>* pending_{nullptr};
+
+    shm_status_t* status_{nullptr};
+
+    shm_axis_status_t* axes_{nullptr};
+
+    shm_command_t* commands_{nullptr};
+
+    std::size_t words_{0};
+};
+
+/**
+ * Client side, for a planner in another process (library `motor_manager_client`). Each axis must be written by one
+ * client thread at a time; any number of threads may read.
+ */
+class SharedMemoryClient {
+public:
+    SharedMemoryClient() = default;
+
+    ~SharedMemoryClient() { close(); }
+
+    SharedMemoryClient(const SharedMemoryClient&) = delete;
+
+    SharedMemoryClient& operator=(const SharedMemoryClient&) = delete;
+
+    /** Maps segment `name`; throws when it does not exist or was created by another layout or version. */
+    void open(const std::string& name);
+
+    void close();
+
+    uint16_t number_of_controllers() const { return header_->number_of_controllers; }
+
+    uint32_t period() const { return header_->period; }
+
+    /** Posts `frame` as axis `index`'s command, taken by the next cycle; wait-free. `false` when `index` is invalid. */
+    bool write(uint16_t index, const motor_interface::motor_frame_t& frame);
+
+    /**
+     * Copies the latest status of every axis, retrying while the RT loop rewrites it (a few microseconds at most);
+     * `valid` and `modes` may be null. Returns the cycle of the snapshot.
+     */
+    uint64_t read(motor_interface::motor_frame_t* status, bool* valid = nullptr, int8_t* modes = nullptr) const;
+
+private:
+    const shm_header_t* header_{nullptr};
+
+    std::size_t length_{0};
+
+    std::atomic<uint64_t>* pending_{nullptr};
+
+    const shm_status_t* status_{nullptr};
+
+    const shm_axis_status_t* axes_{nullptr};
+
+    shm_command_t* commands_{nullptr};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_SHARED_MEMORY_HPP_
@@ -0,0 +1,66 @@
+#ifndef MOTOR_MANAGER_SPSC_RING_HPP_
+#define MOTOR_MANAGER_SPSC_RING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "motor_manager/triple_buffer.hpp"
+
+namespace motor_manager {
+
+/**
+ * Wait-free single-producer / single-consumer FIFO of trivially copyable `T`. Unlike `BoundedQueue` it has no
+ * per-cell sequence numbers: one release store per `push()`, and the consumer can `pop()` in batches.
+ * `N` must be a power of two.
+ */
+template <typename T, std::size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two.");
+
+public:
+    SpscRing() = default;
+
+    SpscRing(const SpscRing&) = delete;
+
+    SpscRing& operator=(const SpscRing&) = delete;
+
+    /** Producer; `false` when the ring is full. */
+    bool push(const T& value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == N) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == N) return false;
+        }
+        cells_[tail & MASK] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Consumer: copies up to `size` values into `out`; returns how many. */
+    std::size_t pop(T* out, std::size_t size)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        const std::size_t available = tail_.load(std::memory_order_acquire) - head;
+        const std::size_t n = available < size ? available : size;
+        for (std::size_t i = 0; i < n; ++i) out[i] = cells_[(head + i) & MASK];
+        head_.store(head + n, std::memory_order_release);
+        return n;
+    }
+
+private:
+    static constexpr std::size_t MASK = N - 1;
+
+    T cells_[N];
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> head_{0};
+
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> tail_{0};
+
+    /** Producer only: last `head_` seen, so a non-full ring costs no load of the consumer's line. */
+    std::size_t head_cache_{0};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_SPSC_RING_HPP_
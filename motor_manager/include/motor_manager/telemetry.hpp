@@ -0,0 +1,229 @@
+#ifndef MOTOR_MANAGER_TELEMETRY_HPP_
+#define MOTOR_MANAGER_TELEMETRY_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#include "motor_manager/spsc_ring.hpp"
+
+namespace motor_manager {
+
+/** "MMTL" in file order. */
+inline constexpr uint32_t TELEMETRY_MAGIC = 0x4C544D4D;
+
+inline constexpr uint32_t TELEMETRY_VERSION = 3;
+
+/** Samples buffered between the RT loop and the writer thread (~250 ms of 16 axes at 4 kHz). */
+inline constexpr std::size_t TELEMETRY_RING_SIZE = 16384;
+
+/** The log file grows and is mapped in windows of this many bytes (a multiple of the page size). */
+inline constexpr std::size_t TELEMETRY_SEGMENT_SIZE = 4 * 1024 * 1024;
+
+/** Sleep of the writer thread while the ring is empty (ms). */
+inline constexpr uint32_t TELEMETRY_DRAIN_PERIOD = 1;
+
+/** Start of a log file; `number_of_samples` and `dropped` are kept current while recording. */
+struct telemetry_header_t {
+    uint32_t magic;
+
+    uint32_t version;
+
+    /** Cycle period (ns). */
+    uint32_t period;
+
+    /** `sizeof(telemetry_sample_t)` of the writer. */
+    uint16_t sample_size;
+
+    uint16_t number_of_axes;
+
+    uint64_t number_of_samples;
+
+    /** Samples the RT loop could not queue because the ring was full. */
+    uint64_t dropped;
+};
+
+/** One axis in one cycle; samples follow the header back to back. Command fields are the targets in SI units. */
+struct telemetry_sample_t {
+    uint64_t cycle;
+
+    /** Application time of the cycle (ns). Starts on `CLOCK_MONOTONIC` and advances one period per cycle; with `clock_sync` it drifts from it. */
+    uint64_t time;
+
+    double command_position;
+
+    double command_velocity;
+
+    double command_torque;
+
+    double position;
+
+    double velocity;
+
+    double torque;
+
+    /** As written to the process image, not as requested by the client. */
+    uint16_t controlword;
+
+    uint16_t statusword;
+
+    uint16_t errorcode;
+
+    uint16_t axis;
+
+    /** The status came from a complete working counter this cycle. */
+    uint8_t valid;
+
+    /** Mode of operation the manager commands (`set_mode()`) and the one the drive displays. */
+    int8_t mode;
+
+    int8_t mode_display;
+
+    /** Bit `id` per RX id (controlword to target torque) in the axis' last command's `target_interface_id`. */
+    uint8_t targets;
+
+    uint8_t reserved[4];
+};
+
+static_assert(sizeof(telemetry_header_t) == 32, "telemetry_header_t is a file format.");
+static_assert(sizeof(telemetry_sample_t) == 80, "telemetry_sample_t is a file format.");
+
+struct telemetry_statistics_t {
+    bool recording{false};
+
+    uint64_t written{0};
+
+    uint64_t dropped{0};
+
+    /** `errno` of the first failed write; the recorder stops writing but keeps counting drops. */
+    int error{0};
+};
+
+/**
+ * Full-rate recorder of per-axis samples. The RT loop `record()`s into an `SpscRing` and never blocks; a writer
+ * thread drains the ring into a memory-mapped, append-only log. `start()` / `stop()` run on one non-RT thread.
+ */
+class TelemetryRecorder {
+public:
+    TelemetryRecorder();
+
+    ~TelemetryRecorder();
+
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+
+    /** Creates (truncates) `path` and starts the writer thread; throws when already recording or the file cannot be created. */
+    void start(const std::string& path, uint32_t period, uint16_t number_of_axes);
+
+    /** Stops recording, writes what is left in the ring and trims the file to its samples. No-op when idle. */
+    void stop();
+
+    /** RT: session to pass to `record()`; `0` while not recording. */
+    uint32_t session() const { return session_.load(std::memory_order_acquire); }
+
+    /** RT: queues `sample`; counts a drop when the ring is full. */
+    void record(uint32_t session, const telemetry_sample_t& sample)
+    {
+        if (!ring_->push(entry_t{session, sample})) dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    telemetry_statistics_t statistics() const;
+
+private:
+    /** The session tags samples so a late push of a stopped session never leaks into the next file. */
+    struct entry_t {
+        uint32_t session;
+        telemetry_sample_t sample;
+    };
+
+    void runWriter();
+
+    /** Writer thread: drains the ring once; returns the number of entries taken. */
+    std::size_t drain();
+
+    bool append(const telemetry_sample_t& sample);
+
+    bool map(std::size_t segment);
+
+    void unmap();
+
+    void writeHeader();
+
+    std::unique_ptr<SpscRing<entry_t, TELEMETRY_RING_SIZE>> ring_;
+
+    std::atomic<uint32_t> session_{0};
+
+    uint32_t last_session_{0};
+
+    std::atomic<uint64_t> dropped_{0};
+
+    /** `dropped_` when the current session started. */
+    std::atomic<uint64_t> dropped_base_{0};
+
+    std::atomic<uint64_t> written_{0};
+
+    std::atomic<int> error_{0};
+
+    std::atomic<bool> stop_{false};
+
+    std::thread writer_;
+
+    int fd_{-1};
+
+    telemetry_header_t header_{};
+
+    /** Writer thread only: mapped window of the file and its index. */
+    uint8_t* window_{nullptr};
+
+    std::size_t segment_{0};
+
+    std::size_t file_size_{0};
+};
+
+/** Read-only view of a log written by `TelemetryRecorder`. */
+class TelemetryLog {
+public:
+    TelemetryLog() = default;
+
+    ~TelemetryLog() { close(); }
+
+    TelemetryLog(const TelemetryLog&) = delete;
+
+    TelemetryLog& operator=(const TelemetryLog&) = delete;
+
+    /** Maps `path`; throws when it is not a telemetry log of this version. Samples past the end of the file are ignored. */
+    void open(const std::string& path);
+
+    void close();
+
+    const telemetry_header_t& header() const { return *header_; }
+
+    const telemetry_sample_t* samples() const { return samples_; }
+
+    std::size_t size() const { return size_; }
+
+private:
+    void* data_{nullptr};
+
+    std::size_t length_{0};
+
+    const telemetry_header_t* header_{nullptr};
+
+    const telemetry_sample_t* samples_{nullptr};
+
+    std::size_t size_{0};
+};
+
+/** One line per sample with a header row; doubles at full precision. */
+void writeCsv(const TelemetryLog& log, std::ostream& out);
+
+/** NumPy `.npy` (format 1.0) structured array with one field per `telemetry_sample_t` member; load with `numpy.load`. */
+void writeNpy(const TelemetryLog& log, std::ostream& out);
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_TELEMETRY_HPP_
@@ -0,0 +1,163 @@
+#ifndef MOTOR_MANAGER_TRAJECTORY_HPP_
+#define MOTOR_MANAGER_TRAJECTORY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "motor_manager/bounded_queue.hpp"
+
+namespace motor_manager {
+
+/** Waypoints queued per axis ahead of the RT loop (~0.3 s at 200 Hz). */
+inline constexpr std::size_t WAYPOINT_QUEUE_SIZE = 64;
+
+/** Shape of the segment that ends at a waypoint. */
+enum class Interpolation : uint8_t {
+    /** Position only; velocity and acceleration are ignored. */
+    Linear,
+    /** Hermite over position and velocity. */
+    Cubic,
+    /** Position, velocity and acceleration at both ends. */
+    Quintic
+};
+
+/** One set-point of a trajectory, in SI units like `motor_frame_t`. */
+struct waypoint_t {
+    /** Target time (ns, `CLOCK_MONOTONIC`, compared with the cycle's wakeup); strictly increasing within an axis. */
+    uint64_t time;
+
+    double position;
+
+    double velocity;
+
+    double acceleration;
+
+    Interpolation interpolation{Interpolation::Cubic};
+};
+
+/**
+ * Per-axis waypoint queue and interpolator. Client threads `push()` into a lock-free bounded queue; the RT loop
+ * calls `sample()` once per cycle, which consumes the waypoints whose time has passed and evaluates the current
+ * segment. A trajectory starts from `start` (the measured position) at the first sampled cycle and holds its
+ * last waypoint once the queue runs dry; the next waypoint continues from that held set-point, at rest, from the
+ * cycle it arrives in. Only `abort()` / `release()` make the next trajectory start from `start` again.
+ */
+class TrajectoryFollower {
+public:
+    /** Any non-RT thread; `false` when the queue is full. */
+    bool push(const waypoint_t& waypoint) { return queue_.push(waypoint); }
+
+    /** RT: set-point at `time`. `false` while no trajectory is active, so the caller leaves the axis alone. */
+    bool sample(uint64_t time, double start, double& position, double& velocity)
+    {
+        double acceleration;
+        return sample(time, start, position, velocity, acceleration);
+    }
+
+    /** RT: as above, with the set-point's acceleration (`0` while holding). */
+    bool sample(uint64_t time, double start, double& position, double& velocity, double& acceleration)
+    {
+        if (!active_) {
+            // After an underrun the set-point in the image is the held waypoint, not the measured position.
+            const double origin = holding_ ? to_.position : start;
+            if (!queue_.pop(to_)) return false;
+            from_ = waypoint_t{time, origin, 0.0, 0.0};
+            active_ = true;
+            holding_ = false;
+        }
+
+        while (time >= to_.time) {
+            waypoint_t next;
+            if (!queue_.pop(next)) {
+                position = to_.position;
+                velocity = 0.0;
+                acceleration = 0.0;
+                active_ = false;
+                holding_ = true;
+                return true;
+            }
+            from_ = to_;
+            to_ = next;
+        }
+
+        evaluate(time, position, velocity, acceleration);
+        return true;
+    }
+
+    /** RT: drops the active segment and every queued waypoint (bounded by the queue size). */
+    void abort()
+    {
+        waypoint_t dropped;
+        for (std::size_t i = 0; i < WAYPOINT_QUEUE_SIZE && queue_.pop(dropped); ++i) {}
+        active_ = false;
+        holding_ = false;
+    }
+
+    /** RT: another command replaced the held set-point in the image; queued waypoints stay. */
+    void release() { holding_ = false; }
+
+    bool active() const { return active_; }
+
+private:
+    void evaluate(uint64_t time, double& position, double& velocity, double& acceleration) const
+    {
+        // sample() already consumed an out-of-order waypoint (its time has passed), collapsing its segment onto the
+        // target; this only guards the division below.
+        if (to_.time <= from_.time) {
+            position = to_.position;
+            velocity = 0.0;
+            acceleration = 0.0;
+            return;
+        }
+
+        const double T = static_cast<double>(to_.time - from_.time) * 1e-9;
+        const double s = time > from_.time ? static_cast<double>(time - from_.time) * 1e-9 / T : 0.0;
+        const double delta = to_.position - from_.position;
+
+        switch (to_.interpolation) {
+        case Interpolation::Linear: {
+            position = from_.position + delta * s;
+            velocity = delta / T;
+            acceleration = 0.0;
+            break;
+        } case Interpolation::Cubic: {
+            const double v0 = from_.velocity * T;
+            const double v1 = to_.velocity * T;
+            const double c2 = 3.0 * delta - 2.0 * v0 - v1;
+            const double c3 = -2.0 * delta + v0 + v1;
+            position = from_.position + s * (v0 + s * (c2 + s * c3));
+            velocity = (v0 + s * (2.0 * c2 + s * 3.0 * c3)) / T;
+            acceleration = (2.0 * c2 + s * 6.0 * c3) / (T * T);
+            break;
+        } case Interpolation::Quintic: {
+            const double v0 = from_.velocity * T;
+            const double v1 = to_.velocity * T;
+            const double a0 = from_.acceleration * T * T;
+            const double a1 = to_.acceleration * T * T;
+            const double c2 = 0.5 * a0;
+            const double c3 = 10.0 * delta - 6.0 * v0 - 4.0 * v1 - 1.5 * a0 + 0.5 * a1;
+            const double c4 = -15.0 * delta + 8.0 * v0 + 7.0 * v1 + 1.5 * a0 - a1;
+            const double c5 = 6.0 * delta - 3.0 * v0 - 3.0 * v1 - 0.5 * a0 + 0.5 * a1;
+            position = from_.position + s * (v0 + s * (c2 + s * (c3 + s * (c4 + s * c5))));
+            velocity = (v0 + s * (2.0 * c2 + s * (3.0 * c3 + s * (4.0 * c4 + s * 5.0 * c5)))) / T;
+            acceleration = (2.0 * c2 + s * (6.0 * c3 + s * (12.0 * c4 + s * 20.0 * c5))) / (T * T);
+            break;
+        }
+        }
+    }
+
+    BoundedQueue<waypoint_t, WAYPOINT_QUEUE_SIZE> queue_;
+
+    /** RT only: the segment being followed. */
+    waypoint_t from_{};
+
+    waypoint_t to_{};
+
+    bool active_{false};
+
+    /** RT only: the queue ran dry and `to_` is the set-point left in the image. */
+    bool holding_{false};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_TRAJECTORY_HPP_
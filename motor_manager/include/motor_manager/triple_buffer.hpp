@@ -0,0 +1,73 @@
+#ifndef MOTOR_MANAGER_TRIPLE_BUFFER_HPP_
+#define MOTOR_MANAGER_TRIPLE_BUFFER_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace motor_manager {
+
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Wait-free single-producer / single-consumer exchange of the latest `T`.
+ * The producer fills `back()` and calls `publish()`; the consumer calls `update()` and reads `front()`.
+ * Neither side ever blocks; intermediate values the consumer did not pick up are overwritten.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    static constexpr uint8_t SIZE = 3;
+
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /** Startup only, before either side runs: copies `value` into all three slots, e.g. to size their storage. */
+    void assign(const T& value)
+    {
+        for (slot_t& slot : slots_) slot.value = value;
+    }
+
+    T& back() { return slots_[back_].value; }
+
+    /** Producer: slot (`0 … SIZE - 1`) behind `back()`, for producers that patch slots incrementally. */
+    uint8_t back_index() const { return back_; }
+
+    void publish()
+    {
+        back_ = middle_.exchange(static_cast<uint8_t>(back_ | FRESH_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /** Returns `true` when a newer value was swapped into `front()`. */
+    bool update()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH_BIT)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    const T& front() const { return slots_[front_].value; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x03;
+
+    static constexpr uint8_t FRESH_BIT = 0x04;
+
+    struct alignas(CACHE_LINE_SIZE) slot_t {
+        T value{};
+    };
+
+    slot_t slots_[SIZE];
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint8_t> middle_{1};
+
+    alignas(CACHE_LINE_SIZE) uint8_t back_{0};
+
+    alignas(CACHE_LINE_SIZE) uint8_t front_{2};
+};
+
+} // namespace motor_manager
+#endif // MOTOR_MANAGER_TRIPLE_BUFFER_HPP_
@@ -0,0 +1,340 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <yaml-cpp/yaml.h>
+
+#include "motor_manager/config_image.hpp"
+
+#include "minas/minas_driver.hpp"
+#include "zeroerr/zeroerr_driver.hpp"
+
+static_assert(std::is_trivially_copyable_v<motor_manager::config_image_t>, "config_image_t must stay plain data.");
+
+namespace {
+
+constexpr uint32_t FNV32_OFFSET = 0x811C9DC5;
+constexpr uint32_t FNV32_PRIME = 0x01000193;
+constexpr uint64_t FNV64_OFFSET = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV64_PRIME = 0x00000100000001B3ULL;
+
+uint64_t fnv64(uint64_t hash, const void* data, std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+void load_domains(const YAML::Node& domains, motor_interface::master_config_t& config)
+{
+    if (!domains.IsSequence() || domains.size() == 0 || domains.size() > motor_interface::MAX_DOMAIN_SIZE) {
+        throw std::runtime_error("Invalid domains configuration.");
+    }
+
+    uint16_t assigned{0};
+    config.number_of_domains = static_cast<uint8_t>(domains.size());
+    for (uint8_t d = 0; d < config.number_of_domains; ++d) {
+        motor_interface::domain_config_t& domain = config.domains[d];
+        if (domains[d]["divider"]) domain.divider = domains[d]["divider"].as<uint32_t>();
+        if (domain.divider == 0) throw std::runtime_error("Invalid domain divider.");
+        if (d == 0) {
+            if (domain.divider != 1) throw std::runtime_error("The first domain must be exchanged every cycle.");
+            continue;
+        }
+
+        YAML::Node interfaces = domains[d]["interfaces"];
+        if (!interfaces || !interfaces.IsSequence()) throw std::runtime_error("Invalid domain interfaces.");
+        for (const auto& i : interfaces) {
+            const unsigned int id = i.as<unsigned int>();
+            if (id >= motor_interface::NUMBER_OF_INTERFACE_IDS || (assigned & (1u << id))) {
+                throw std::runtime_error("Invalid domain interface ID.");
+            }
+            if (id == motor_interface::ID_CONTROLWORD || id == motor_interface::ID_STATUSWORD) {
+                throw std::runtime_error("Controlword and statusword must stay in the first domain.");
+            }
+            domain.interfaces |= static_cast<uint16_t>(1u << id);
+            assigned |= static_cast<uint16_t>(1u << id);
+        }
+    }
+}
+
+void add_source(motor_manager::config_image_t& image, const std::string& path)
+{
+    const std::string absolute = std::filesystem::absolute(path).lexically_normal().string();
+    if (absolute.size() >= motor_manager::MAX_SOURCE_PATH) throw std::runtime_error("Configuration path too long.");
+    if (image.number_of_sources >= motor_manager::MAX_SOURCE_SIZE) throw std::runtime_error("Too many configuration sources.");
+    std::memcpy(image.sources[image.number_of_sources++], absolute.c_str(), absolute.size() + 1);
+}
+
+std::unique_ptr<motor_interface::MotorDriver> make_driver(
+    motor_manager::DriverType type,
+    const motor_interface::driver_config_t& config)
+{
+    switch (type) {
+    case motor_manager::DriverType::Minas: return std::make_unique<minas::MinasDriver>(config);
+    case motor_manager::DriverType::Zeroerr: return std::make_unique<zeroerr::ZeroerrDriver>(config);
+    default: throw std::runtime_error("Invalid driver type.");
+    }
+}
+
+} // namespace
+
+void motor_manager::compileConfiguration(const std::string& config_file, config_image_t& image)
+{
+    // Zero the padding too: the whole block is checksummed and written as is.
+    std::memset(static_cast<void*>(&image), 0, sizeof(image));
+
+    YAML::Node root = YAML::LoadFile(config_file);
+    if (!root) throw std::runtime_error("Failed to load configuration file.");
+    add_source(image, config_file);
+
+    image.period = root["period"].as<uint32_t>();
+    if (root["parallel_masters"]) image.parallel_masters = root["parallel_masters"].as<bool>();
+    image.max_consecutive_errors = root["max_consecutive_errors"]
+        ? root["max_consecutive_errors"].as<uint32_t>() : DEFAULT_MAX_CONSECUTIVE_ERRORS;
+
+    YAML::Node clock_sync = root["clock_sync"];
+    if (clock_sync) {
+        image.clock_sync = true;
+        image.kp = clock_sync["kp"] ? clock_sync["kp"].as<double>() : 0.01;
+        image.ki = clock_sync["ki"] ? clock_sync["ki"].as<double>() : 0.00001;
+        image.max_correction = clock_sync["max_correction"] ? clock_sync["max_correction"].as<int64_t>() : image.period / 100;
+        if (clock_sync["master"]) {
+            image.has_sync_master = true;
+            image.sync_master_id = clock_sync["master"].as<uint8_t>();
+        }
+    }
+
+    image_thread_config_t& rt = image.realtime;
+    YAML::Node realtime = root["realtime"];
+    if (realtime) {
+        if (realtime["cpus"]) {
+            YAML::Node cpus = realtime["cpus"];
+            const std::vector<int> list = cpus.IsSequence() ? cpus.as<std::vector<int>>() : parseCpuList(cpus.as<std::string>());
+            if (list.size() > MAX_IMAGE_CPUS) throw std::runtime_error("Too many realtime CPUs.");
+            for (int cpu : list) rt.cpus[rt.number_of_cpus++] = cpu;
+        }
+        if (realtime["policy"]) rt.policy = toSchedulingPolicy(realtime["policy"].as<std::string>());
+        if (realtime["priority"]) rt.priority = realtime["priority"].as<int>();
+        if (realtime["runtime"]) rt.runtime = realtime["runtime"].as<uint64_t>();
+        if (realtime["deadline"]) rt.deadline = realtime["deadline"].as<uint64_t>();
+    }
+
+    YAML::Node masters = root["masters"];
+    if (!masters || !masters.IsSequence()) throw std::runtime_error("Invalid masters configuration.");
+
+    for (const auto& m : masters) {
+        if (image.number_of_masters >= MAX_MASTER_SIZE) throw std::runtime_error("Too many masters.");
+        image_master_t& master = image.masters[image.number_of_masters++];
+        master.config = motor_interface::master_config_t{};
+        master.cpu = m["cpu"] ? m["cpu"].as<int>() : -1;
+
+        motor_interface::master_config_t& m_cfg = master.config;
+        m_cfg.id = m["id"].as<uint8_t>();
+        m_cfg.number_of_slaves = m["number_of_slaves"].as<uint16_t>();
+        if (m["domains"]) load_domains(m["domains"], m_cfg);
+
+        YAML::Node slaves = m["slaves"];
+        if (!slaves || !slaves.IsSequence()) throw std::runtime_error("Invalid slaves configuration.");
+
+        master.type = toCommunicationType(m["type"].as<std::string>());
+        switch (master.type) {
+        case CommunicationType::Ethercat: {
+            m_cfg.master_index = m["master_index"].as<unsigned int>();
+            break;
+        } case CommunicationType::Simulation: {
+            if (m["time_constant"]) m_cfg.time_constant = m["time_constant"].as<double>();
+            if (m["clock_drift"]) m_cfg.clock_drift = m["clock_drift"].as<double>();
+            if (m["bus_error"]) {
+                m_cfg.bus_error_after = m["bus_error"]["after"].as<uint32_t>();
+                m_cfg.bus_error_cycles = m["bus_error"]["cycles"].as<uint32_t>();
+            }
+            if (m["frame_loss"]) {
+                m_cfg.frame_loss_after = m["frame_loss"]["after"].as<uint32_t>();
+                m_cfg.frame_loss_cycles = m["frame_loss"]["cycles"].as<uint32_t>();
+            }
+            break;
+        } default: {
+            throw std::runtime_error("Invalid communication type.");
+        }
+        }
+
+        for (uint16_t i = 0; i < m_cfg.number_of_slaves; ++i) {
+            if (image.number_of_slaves >= MAX_CONTROLLER_SIZE) throw std::runtime_error("Too many controllers.");
+            motor_interface::slave_config_t& s_cfg = image.slaves[image.number_of_slaves++];
+            s_cfg = motor_interface::slave_config_t{};
+            s_cfg.controller_index = slaves[i]["controller_index"].as<uint16_t>();
+            s_cfg.master_id = m_cfg.id;
+            s_cfg.driver_id = slaves[i]["driver_id"].as<uint8_t>();
+            if (master.type == CommunicationType::Ethercat) {
+                s_cfg.alias = slaves[i]["alias"].as<uint16_t>();
+                s_cfg.position = slaves[i]["position"].as<uint16_t>();
+                s_cfg.vendor_id = slaves[i]["vendor_id"].as<uint32_t>();
+                s_cfg.product_id = slaves[i]["product_id"].as<uint32_t>();
+            }
+        }
+    }
+
+    YAML::Node drivers = root["drivers"];
+    if (!drivers || !drivers.IsSequence()) throw std::runtime_error("Invalid drivers configuration.");
+
+    for (const auto& d : drivers) {
+        if (image.number_of_drivers >= MAX_DRIVER_SIZE) throw std::runtime_error("Too many drivers.");
+        image_driver_t& driver = image.drivers[image.number_of_drivers++];
+
+        motor_interface::driver_config_t& d_cfg = driver.config;
+        d_cfg = motor_interface::driver_config_t{};
+        d_cfg.id = d["id"].as<uint8_t>();
+        d_cfg.pulse_per_revolution = d["pulse_per_revolution"].as<uint32_t>();
+        d_cfg.rated_torque = d["rated_torque"].as<double>();
+        d_cfg.unit_torque = d["unit_torque"].as<double>();
+        d_cfg.lower = d["lower"].as<double>();
+        d_cfg.upper = d["upper"].as<double>();
+        d_cfg.speed = d["speed"].as<double>();
+        d_cfg.acceleration = d["acceleration"].as<double>();
+        d_cfg.deceleration = d["deceleration"].as<double>();
+        d_cfg.profile_velocity = d["profile_velocity"].as<double>();
+        d_cfg.profile_acceleration = d["profile_acceleration"].as<double>();
+        d_cfg.profile_deceleration = d["profile_deceleration"].as<double>();
+        driver.type = toDriverType(d["type"].as<std::string>());
+
+        std::string param_path = d["param_file"].as<std::string>();
+        const std::filesystem::path param_fs(param_path);
+        if (!param_fs.is_absolute()) {
+            const std::filesystem::path base =
+                std::filesystem::path(config_file).parent_path();
+            param_path = (base / param_fs).lexically_normal().string();
+        }
+
+        std::unique_ptr<motor_interface::MotorDriver> parser = make_driver(driver.type, d_cfg);
+        parser->loadParameters(param_path);
+        driver.tables = parser->tables();
+        add_source(image, param_path);
+    }
+
+    image.header.magic = CONFIG_IMAGE_MAGIC;
+    image.header.version = CONFIG_IMAGE_VERSION;
+    image.header.size = static_cast<uint32_t>(sizeof(config_image_t));
+    image.header.source_hash = hashSources(image);
+    image.header.checksum = checksum(image);
+}
+
+uint64_t motor_manager::hashSources(const config_image_t& image)
+{
+    uint64_t hash = FNV64_OFFSET;
+    std::vector<char> buffer;
+    for (uint8_t s = 0; s < image.number_of_sources && s < MAX_SOURCE_SIZE; ++s) {
+        const char* path = image.sources[s];
+        const std::size_t length = strnlen(path, MAX_SOURCE_PATH);
+        if (length == MAX_SOURCE_PATH) return 0;
+        hash = fnv64(hash, path, length + 1);
+
+        std::ifstream file(path, std::ios::binary);
+        if (!file) return 0;
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        const uint64_t size = buffer.size();
+        hash = fnv64(hash, &size, sizeof(size));
+        hash = fnv64(hash, buffer.data(), buffer.size());
+    }
+    return hash ? hash : 1;
+}
+
+uint32_t motor_manager::checksum(const config_image_t& image)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&image) + sizeof(config_image_header_t);
+    const std::size_t size = sizeof(config_image_t) - sizeof(config_image_header_t);
+
+    uint32_t hash = FNV32_OFFSET;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV32_PRIME;
+    }
+    return hash;
+}
+
+std::string motor_manager::configCachePath(const std::string& config_file)
+{
+    std::filesystem::path directory;
+    if (const char* dir = std::getenv(CONFIG_CACHE_DIR_ENV); dir && *dir) {
+        directory = dir;
+    } else if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        directory = std::filesystem::path(xdg) / "motor_manager";
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        directory = std::filesystem::path(home) / ".cache" / "motor_manager";
+    } else {
+        return {};
+    }
+
+    const std::string absolute = std::filesystem::absolute(config_file).lexically_normal().string();
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.image",
+        static_cast<unsigned long long>(fnv64(FNV64_OFFSET, absolute.data(), absolute.size())));
+    return (directory / name).string();
+}
+
+bool motor_manager::saveConfigImage(const config_image_t& image, const std::string& path)
+{
+    std::error_code error;
+    const std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty()) std::filesystem::create_directories(parent, error);
+
+    const std::string temporary = path + ".tmp." + std::to_string(getpid());
+    FILE* file = std::fopen(temporary.c_str(), "wb");
+    if (!file) return false;
+
+    const bool written = std::fwrite(&image, sizeof(image), 1, file) == 1;
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool motor_manager::ConfigImageMapping::open(const std::string& path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || static_cast<std::size_t>(info.st_size) != sizeof(config_image_t)) {
+        ::close(fd);
+        return false;
+    }
+
+    void* data = mmap(nullptr, sizeof(config_image_t), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) return false;
+
+    image_ = static_cast<const config_image_t*>(data);
+    const config_image_header_t& header = image_->header;
+    if (header.magic != CONFIG_IMAGE_MAGIC ||
+        header.version != CONFIG_IMAGE_VERSION ||
+        header.size != sizeof(config_image_t) ||
+        header.checksum != checksum(*image_)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void motor_manager::ConfigImageMapping::close()
+{
+    if (!image_) return;
+    munmap(const_cast<config_image_t*>(image_), sizeof(config_image_t));
+    image_ = nullptr;
+}
@@ -1,17 +1,24 @@
 #include <algorithm>
+#include <cstdio>
 #include <cstring>
-#include <filesystem>
+#include <thread>
+#include <vector>
 
 #include <time.h>
 #include <sched.h>
 #include <errno.h>
 #include <unistd.h>
 #include <sys/mman.h>
-#include <yaml-cpp/yaml.h>
 
 #include "motor_manager/motor_manager.hpp"
+#include "motor_manager/config_image.hpp"
+#include "motor_manager/driver_dispatch.hpp"
+#ifdef MOTOR_MANAGER_WITH_ETHERCAT
 #include "ethercat/ethercat_master.hpp"
 #include "ethercat/ethercat_controller.hpp"
+#endif
+#include "simulation/simulation_master.hpp"
+#include "simulation/simulation_controller.hpp"
 
 #include "minas/minas_driver.hpp"
 #include "zeroerr/zeroerr_driver.hpp"
@@ -29,10 +36,92 @@ void stack_prefault()
     std::memset(dummy, 0, sizeof(dummy));
 }
 
+void now(timespec& time)
+{
+    clock_gettime(CLOCK_MONOTONIC, &time);
+}
+
+uint64_t elapsed(const timespec& from, const timespec& to)
+{
+    const int64_t ns =
+        static_cast<int64_t>(to.tv_sec - from.tv_sec) * static_cast<int64_t>(motor_manager::NSEC_PER_SEC) +
+        static_cast<int64_t>(to.tv_nsec - from.tv_nsec);
+    return ns > 0 ? static_cast<uint64_t>(ns) : 0;
+}
+
+void advance(timespec& time, int64_t ns)
+{
+    const int64_t sec = static_cast<int64_t>(motor_manager::NSEC_PER_SEC);
+    int64_t nsec = static_cast<int64_t>(time.tv_nsec) + ns % sec;
+    time.tv_sec += static_cast<time_t>(ns / sec);
+    if (nsec >= sec) {
+        time.tv_sec++;
+        nsec -= sec;
+    } else if (nsec < 0) {
+        time.tv_sec--;
+        nsec += sec;
+    }
+    time.tv_nsec = static_cast<long>(nsec);
+}
+
+uint64_t nanoseconds(const timespec& time)
+{
+    return static_cast<uint64_t>(time.tv_sec) * motor_manager::NSEC_PER_SEC + static_cast<uint64_t>(time.tv_nsec);
+}
+
+constexpr std::size_t AXES_PER_WORD = 64;
+
+/** The fields `writeCounts()` sends; status fields and the 8-bit `controller_index` do not count. */
+bool same_command(const motor_interface::motor_frame_t& a, const motor_interface::motor_frame_t& b)
+{
+    if (a.controlword != b.controlword ||
+        a.position != b.position ||
+        a.velocity != b.velocity ||
+        a.torque != b.torque ||
+        a.number_of_target_interfaces != b.number_of_target_interfaces) {
+        return false;
+    }
+    const uint8_t n = std::min(a.number_of_target_interfaces, motor_interface::MAX_INTERFACE_SIZE);
+    return std::equal(a.target_interface_id, a.target_interface_id + n, b.target_interface_id);
+}
+
+/** `frame` lists `id` among its target interfaces. */
+bool targets(const motor_interface::motor_frame_t& frame, uint8_t id)
+{
+    const uint8_t n = std::min(frame.number_of_target_interfaces, motor_interface::MAX_INTERFACE_SIZE);
+    return std::find(frame.target_interface_id, frame.target_interface_id + n, id) != frame.target_interface_id + n;
+}
+
+/** Target interface the cyclic setpoint of `mode` goes to. */
+uint8_t mode_target(int8_t mode)
+{
+    switch (static_cast<motor_interface::OperationMode>(mode)) {
+    case motor_interface::OperationMode::CyclicSyncVelocity: return motor_interface::ID_TARGET_VELOCITY;
+    case motor_interface::OperationMode::CyclicSyncTorque: return motor_interface::ID_TARGET_TORQUE;
+    default: return motor_interface::ID_TARGET_POSITION;
+    }
+}
+
+/** Mode of operation the driver's startup `items` configure; CSP when they do not set a cyclic one. */
+int8_t startup_mode(const motor_interface::MotorDriver& driver)
+{
+    const motor_interface::entry_table_t* items = driver.items();
+    for (uint8_t i = 0; i < driver.number_of_items(); ++i) {
+        if (items[i].index != motor_interface::OD_MODE_OF_OPERATION || items[i].subindex != 0) continue;
+        const int8_t mode = static_cast<int8_t>(items[i].data[0]);
+        if (motor_interface::isCyclicMode(mode)) return mode;
+    }
+    return static_cast<int8_t>(motor_interface::OperationMode::CyclicSyncPosition);
+}
+
 } // namespace
 
 motor_manager::MotorManager::MotorManager(const std::string& config_file)
 {
+    std::fill(std::begin(master_lookup_), std::end(master_lookup_), UNASSIGNED_SLOT);
+    std::fill(std::begin(driver_lookup_), std::end(driver_lookup_), UNASSIGNED_SLOT);
+    std::fill(std::begin(master_cpus_), std::end(master_cpus_), -1);
+
     loadConfigurations(config_file);
 
     initialize();
@@ -40,88 +129,122 @@ motor_manager::MotorManager::MotorManager(const std::string& config_file)
 
 void motor_manager::MotorManager::loadConfigurations(const std::string& config_file)
 {
-    YAML::Node root = YAML::LoadFile(config_file);
-    if (!root) throw std::runtime_error("Failed to load configuration file.");
+    const std::string cache_file = configCachePath(config_file);
 
-    period_ = root["period"].as<uint32_t>();
+    // a precompiled image next to the YAML first (read-only installs), then the per-user cache
+    for (const std::string& path : {config_file + CONFIG_IMAGE_SUFFIX, cache_file}) {
+        ConfigImageMapping mapping;
+        if (path.empty() || !mapping.open(path)) continue;
+        if (mapping.image().header.source_hash != hashSources(mapping.image())) continue;
+        build(mapping.image());
+        loaded_from_cache_ = true;
+        return;
+    }
 
-    YAML::Node masters = root["masters"];
-    if (!masters || !masters.IsSequence()) throw std::runtime_error("Invalid masters configuration.");
+    auto image = std::make_unique<config_image_t>();
+    compileConfiguration(config_file, *image);
+    if (cache_file.empty() || !saveConfigImage(*image, cache_file)) {
+        std::fprintf(stderr, "motor_manager: could not cache the compiled configuration; it is parsed from YAML on every start.\n");
+    }
+    build(*image);
+}
 
-    uint8_t s_idx{0};
-    masters_.reserve(MAX_MASTER_SIZE);
-    for (const auto& m : masters) {
-        motor_interface::master_config_t m_cfg{};
-        m_cfg.id = m["id"].as<uint8_t>();
-        m_cfg.number_of_slaves = m["number_of_slaves"].as<uint8_t>();
+void motor_manager::MotorManager::build(const config_image_t& image)
+{
+    period_ = image.period;
+    parallel_masters_ = image.parallel_masters;
+    max_consecutive_errors_ = image.max_consecutive_errors;
 
-        YAML::Node slaves = m["slaves"];
-        if (!slaves || !slaves.IsSequence()) throw std::runtime_error("Invalid slaves configuration.");
+    clock_sync_ = image.clock_sync;
+    if (clock_sync_) drift_.configure(period_, image.kp, image.ki, image.max_correction);
 
-        switch (toCommunicationType(m["type"].as<std::string>())) {
-        case CommunicationType::Ethercat: {
-            m_cfg.master_index = m["master_index"].as<unsigned int>();
-            masters_[m_cfg.id] = std::make_unique<ethercat::EthercatMaster>(m_cfg);
-
-            for (uint8_t i = 0; i < m["number_of_slaves"].as<uint8_t>(); ++i) {
-                motor_interface::slave_config_t s_cfg{};
-                s_cfg.controller_index = slaves[i]["controller_index"].as<uint8_t>();
-                s_cfg.master_id = m_cfg.id;
-                s_cfg.driver_id = slaves[i]["driver_id"].as<uint8_t>();
-                s_cfg.alias = slaves[i]["alias"].as<uint16_t>();
-                s_cfg.position = slaves[i]["position"].as<uint16_t>();
-                s_cfg.vendor_id = slaves[i]["vendor_id"].as<uint32_t>();
-                s_cfg.product_id = slaves[i]["product_id"].as<uint32_t>();
+    rt_config_.period = period_;
+    rt_config_.cpus.assign(image.realtime.cpus, image.realtime.cpus + image.realtime.number_of_cpus);
+    rt_config_.policy = image.realtime.policy;
+    rt_config_.priority = image.realtime.priority;
+    rt_config_.runtime = image.realtime.runtime;
+    rt_config_.deadline = image.realtime.deadline;
 
-                controllers_[s_cfg.controller_index] = std::make_unique<ethercat::EthercatController>(s_cfg);
-                s_idx++;
-            }
+    controllers_.clear();
+    controllers_.resize(image.number_of_slaves);
+
+    uint16_t s_idx{0};
+    for (uint8_t k = 0; k < image.number_of_masters; ++k) {
+        const image_master_t& master = image.masters[k];
+        const motor_interface::master_config_t& m_cfg = master.config;
+
+        if (number_of_masters_ >= MAX_MASTER_SIZE) throw std::runtime_error("Too many masters.");
+        if (master_lookup_[m_cfg.id] != UNASSIGNED_SLOT) throw std::runtime_error("Duplicate master ID.");
+        const uint8_t m_slot = number_of_masters_++;
+        master_lookup_[m_cfg.id] = m_slot;
+        master_cpus_[m_slot] = master.cpu;
+
+        switch (master.type) {
+#ifdef MOTOR_MANAGER_WITH_ETHERCAT
+        case CommunicationType::Ethercat: {
+            masters_[m_slot] = std::make_unique<ethercat::EthercatMaster>(m_cfg);
+            break;
+        }
+#endif
+        case CommunicationType::Simulation: {
+            masters_[m_slot] = std::make_unique<simulation::SimulationMaster>(m_cfg);
             break;
         } default: {
             throw std::runtime_error("Invalid communication type.");
         }
         }
+
+        for (uint16_t i = 0; i < m_cfg.number_of_slaves; ++i) {
+            if (s_idx >= image.number_of_slaves) throw std::runtime_error("Invalid controller index.");
+            const motor_interface::slave_config_t& s_cfg = image.slaves[s_idx];
+            if (s_cfg.controller_index >= controllers_.size() || controllers_[s_cfg.controller_index]) {
+                throw std::runtime_error("Invalid controller index.");
+            }
+
+            switch (master.type) {
+#ifdef MOTOR_MANAGER_WITH_ETHERCAT
+            case CommunicationType::Ethercat: {
+                controllers_[s_cfg.controller_index] = std::make_unique<ethercat::EthercatController>(s_cfg);
+                break;
+            }
+#endif
+            default: {
+                controllers_[s_cfg.controller_index] = std::make_unique<simulation::SimulationController>(s_cfg);
+                break;
+            }
+            }
+            s_idx++;
+        }
     }
     number_of_controllers_ = s_idx;
+    if (clock_sync_) {
+        sync_master_ = image.has_sync_master ? masterSlot(image.sync_master_id) : 0;
+    }
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        if (!controllers_[i]) throw std::runtime_error("Controller indices must be contiguous from 0.");
+    }
+
+    for (uint8_t k = 0; k < image.number_of_drivers; ++k) {
+        const image_driver_t& driver = image.drivers[k];
+        const motor_interface::driver_config_t& d_cfg = driver.config;
+
+        if (number_of_drivers_ >= MAX_DRIVER_SIZE) throw std::runtime_error("Too many drivers.");
+        if (driver_lookup_[d_cfg.id] != UNASSIGNED_SLOT) throw std::runtime_error("Duplicate driver ID.");
+        const uint8_t d_slot = number_of_drivers_++;
+        driver_lookup_[d_cfg.id] = d_slot;
 
-    YAML::Node drivers = root["drivers"];
-    if (!drivers || !drivers.IsSequence()) throw std::runtime_error("Invalid drivers configuration.");
-
-    drivers_.reserve(MAX_DRIVER_SIZE);
-    for (const auto& d : drivers) {
-        motor_interface::driver_config_t d_cfg{};
-        d_cfg.id = d["id"].as<uint8_t>();
-        d_cfg.pulse_per_revolution = d["pulse_per_revolution"].as<uint32_t>();
-        d_cfg.rated_torque = d["rated_torque"].as<double>();
-        d_cfg.unit_torque = d["unit_torque"].as<double>();
-        d_cfg.lower = d["lower"].as<double>();
-        d_cfg.upper = d["upper"].as<double>();
-        d_cfg.speed = d["speed"].as<double>();
-        d_cfg.acceleration = d["acceleration"].as<double>();
-        d_cfg.deceleration = d["deceleration"].as<double>();
-        d_cfg.profile_velocity = d["profile_velocity"].as<double>();
-        d_cfg.profile_acceleration = d["profile_acceleration"].as<double>();
-        d_cfg.profile_deceleration = d["profile_deceleration"].as<double>();
-
-        switch (toDriverType(d["type"].as<std::string>())) {
+        switch (driver.type) {
         case DriverType::Minas: {
-            drivers_[d_cfg.id] = std::make_unique<minas::MinasDriver>(d_cfg);
+            drivers_[d_slot] = std::make_unique<minas::MinasDriver>(d_cfg);
             break;
         } case DriverType::Zeroerr: {
-            drivers_[d_cfg.id] = std::make_unique<zeroerr::ZeroerrDriver>(d_cfg);
+            drivers_[d_slot] = std::make_unique<zeroerr::ZeroerrDriver>(d_cfg);
             break;
         } default: {
             throw std::runtime_error("Invalid driver type.");
         }
         }
-        std::string param_path = d["param_file"].as<std::string>();
-        const std::filesystem::path param_fs(param_path);
-        if (!param_fs.is_absolute()) {
-            const std::filesystem::path base =
-                std::filesystem::path(config_file).parent_path();
-            param_path = (base / param_fs).lexically_normal().string();
-        }
-        drivers_.at(d_cfg.id)->loadParameters(param_path);
+        drivers_[d_slot]->loadTables(driver.tables);
     }
 }
 
@@ -129,57 +252,346 @@ void motor_manager::MotorManager::initialize()
 {
     frequency_ = NSEC_PER_SEC / period_;
 
-    for (auto& m_iter : masters_) m_iter.second->initialize();
+    for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->initialize();
+
+    const uint16_t n = number_of_controllers_;
+    converter_.resize(n);
+    status_lanes_.resize(n);
+    command_lanes_.resize(n);
+    controller_order_.assign(n, 0);
+    controller_master_.assign(n, 0);
+    dispatch_.assign(n, driver_handle_t{});
+    rt_status_.assign(n, motor_interface::motor_frame_t{});
+    following_.assign(n, 0);
+    trajectories_ = std::make_unique<TrajectoryFollower[]>(n);
+    sdo_.resize(n);
+
+    pending_command_.resize(n);
+    command_.assign(pending_command_);
+    dirty_words_ = (n + AXES_PER_WORD - 1) / AXES_PER_WORD;
+    staged_.assign(dirty_words_, 0);
+    for (auto& stale : stale_) stale.assign(dirty_words_, 0);
+    dirty_ = std::make_unique<std::atomic<uint64_t>[]>(dirty_words_);
+    for (std::size_t w = 0; w < dirty_words_; ++w) dirty_[w].store(0, std::memory_order_relaxed);
+    rt_dirty_.assign(dirty_words_, 0);
+    rt_fresh_.assign(dirty_words_, 0);
+    overridden_.assign(dirty_words_, 0);
+    foreign_ = std::make_unique<std::atomic<uint64_t>[]>(dirty_words_);
+    for (std::size_t w = 0; w < dirty_words_; ++w) foreign_[w].store(0, std::memory_order_relaxed);
+    rt_foreign_.assign(dirty_words_, 0);
+    rt_commands_.assign(n, motor_interface::motor_frame_t{});
+    reset_requests_ = std::make_unique<std::atomic<uint64_t>[]>(dirty_words_);
+    for (std::size_t w = 0; w < dirty_words_; ++w) reset_requests_[w].store(0, std::memory_order_relaxed);
+    axis_states_.assign(n, AxisState::Healthy);
+    requested_stops_ = std::make_unique<std::atomic<uint8_t>[]>(n);
+    stop_requests_ = std::make_unique<std::atomic<uint64_t>[]>(dirty_words_);
+    for (std::size_t w = 0; w < dirty_words_; ++w) stop_requests_[w].store(0, std::memory_order_relaxed);
+    rt_stop_requests_.assign(dirty_words_, 0);
+    stop_goals_.assign(n, motor_interface::Cia402Goal::Enable);
+    requested_modes_ = std::make_unique<std::atomic<int8_t>[]>(n);
+    mode_requests_ = std::make_unique<std::atomic<uint64_t>[]>(dirty_words_);
+    for (std::size_t w = 0; w < dirty_words_; ++w) mode_requests_[w].store(0, std::memory_order_relaxed);
+    rt_mode_requests_.assign(dirty_words_, 0);
+    modes_.assign(n, 0);
+    displayed_modes_.assign(n, 0);
+    mode_cycles_.assign(n, 0);
+    displays_mode_.assign(n, 0);
+    cia402_.assign(n, nullptr);
+    cia402_axes_.assign(n, motor_interface::cia402_axis_t{});
+    frame_block_t status;
+    status.resize(n);
+    status_.assign(status);
 
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        uint8_t m_id = controllers_[i]->master_id();
-        uint8_t d_id = controllers_[i]->driver_id();
-        controllers_[i]->initialize(*masters_.at(m_id), *drivers_.at(d_id));
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        uint8_t m_slot = masterSlot(controllers_[i]->master_id());
+        uint8_t d_slot = driverSlot(controllers_[i]->driver_id());
+        controllers_[i]->initialize(*masters_[m_slot], *drivers_[d_slot]);
+        converter_.configure(i, drivers_[d_slot]->scale());
+        cia402_[i] = &drivers_[d_slot]->cia402();
+        modes_[i] = startup_mode(*drivers_[d_slot]);
+        displayed_modes_[i] = modes_[i];
+        requested_modes_[i].store(modes_[i], std::memory_order_relaxed);
+        displays_mode_[i] = (controllers_[i]->mapped() >> motor_interface::ID_MODE_OF_OPERATION_DISPLAY) & 1u;
+        dispatch_[i] = toDriverHandle(drivers_[d_slot].get());
     }
+
+    uint16_t c_idx{0};
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        master_begin_[m] = c_idx;
+        for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+            if (masterSlot(controllers_[i]->master_id()) == m) {
+                controller_order_[c_idx++] = i;
+                controller_master_[i] = m;
+            }
+        }
+    }
+    master_begin_[number_of_masters_] = c_idx;
+
+    trajectory_frame_.number_of_target_interfaces = 1;
+    trajectory_frame_.target_interface_id[0] = motor_interface::ID_TARGET_POSITION;
+
+    switch_frame_.number_of_target_interfaces = 1;
+
+    rt_health_.number_of_masters = number_of_masters_;
+    health_.back() = rt_health_;
+    health_.publish();
+}
+
+uint8_t motor_manager::MotorManager::masterSlot(uint8_t id) const
+{
+    if (master_lookup_[id] == UNASSIGNED_SLOT) throw std::runtime_error("Invalid master ID.");
+    return master_lookup_[id];
+}
+
+uint8_t motor_manager::MotorManager::driverSlot(uint8_t id) const
+{
+    if (driver_lookup_[id] == UNASSIGNED_SLOT) throw std::runtime_error("Invalid driver ID.");
+    return driver_lookup_[id];
 }
 
 void motor_manager::MotorManager::enable()
 {
-    uint8_t result[MAX_CONTROLLER_SIZE]{0};
-    uint8_t sum{0};
+    is_enable_ = walk(motor_interface::Cia402Goal::Enable) == number_of_controllers_;
+}
+
+void motor_manager::MotorManager::disable()
+{
+    is_disabled_ = walk(motor_interface::Cia402Goal::Disable) == number_of_controllers_;
+}
 
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        if (!result[i]) result[i] = controllers_[i]->enable();
-        sum += result[i];
+uint16_t motor_manager::MotorManager::walk(motor_interface::Cia402Goal goal)
+{
+    uint16_t reached{0};
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        if (!data_valid_[m]) continue;  // no step on stale statuswords
+        for (uint16_t k = master_begin_[m]; k < master_begin_[m + 1]; ++k) {
+            const uint16_t i = controller_order_[k];
+            controllers_[i]->readCounts(rt_status_[i], status_lanes_);
+            if (transition(i, goal)) reached++;
+        }
     }
-    is_enable_ = sum == number_of_controllers_;
+    return reached;
 }
 
-void motor_manager::MotorManager::disable()
+bool motor_manager::MotorManager::transition(uint16_t index, motor_interface::Cia402Goal goal)
 {
-    uint8_t result[MAX_CONTROLLER_SIZE]{0};
-    uint8_t sum{0};
+    uint16_t controlword{0};
+    if (motor_interface::step(*cia402_[index], goal, rt_status_[index].statusword, cia402_axes_[index], controlword)) return true;
+    controllers_[index]->writeControlword(controlword);
+    return false;
+}
+
+bool motor_manager::MotorManager::hold(uint16_t index, motor_interface::Cia402Goal goal)
+{
+    uint16_t controlword{0};
+    const bool reached = motor_interface::step(*cia402_[index], goal, rt_status_[index].statusword, cia402_axes_[index], controlword);
+    controllers_[index]->writeControlword(controlword);
+    return reached;
+}
 
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        if (!result[i]) result[i] = controllers_[i]->disable();
-        sum += result[i];
+void motor_manager::MotorManager::writeMeasured(uint16_t index)
+{
+    command_lanes_.position[index] = rt_status_[index].position;
+    command_lanes_.velocity[index] = rt_status_[index].velocity;
+    command_lanes_.torque[index] = rt_status_[index].torque;
+    command_lanes_.position_count[index] = status_lanes_.position_count[index];
+    command_lanes_.velocity_count[index] = status_lanes_.velocity_count[index];
+    command_lanes_.torque_count[index] = status_lanes_.torque_count[index];
+    switch_frame_.target_interface_id[0] = mode_target(modes_[index]);
+    controllers_[index]->writeCounts(switch_frame_, command_lanes_);
+}
+
+void motor_manager::MotorManager::write(const motor_interface::motor_frame_t* command, const uint16_t size)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    claim();
+    const uint16_t n = std::min(size, number_of_controllers_);
+    for (uint16_t i = 0; i < n; ++i) stage(i, command[i]);
+    commit();
+}
+
+void motor_manager::MotorManager::write(const axis_command_t* commands, uint16_t size)
+{
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    claim();
+    for (uint16_t k = 0; k < size; ++k) {
+        if (commands[k].index < number_of_controllers_) stage(commands[k].index, commands[k].frame);
     }
-    is_disabled_ = sum == number_of_controllers_;
+    commit();
 }
 
-void motor_manager::MotorManager::write(const motor_interface::motor_frame_t* command, const uint8_t size)
+void motor_manager::MotorManager::claim()
 {
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    const uint8_t n = std::min(size, MAX_CONTROLLER_SIZE);
-    for (uint8_t i = 0; i < n; ++i) {
-        command_[i] = command[i];
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        if (foreign_[w].load(std::memory_order_relaxed)) overridden_[w] |= foreign_[w].exchange(0, std::memory_order_acquire);
     }
-    is_command_changed_.store(true, std::memory_order_release);
+}
+
+void motor_manager::MotorManager::stage(uint16_t index, const motor_interface::motor_frame_t& frame)
+{
+    motor_interface::motor_frame_t& pending = pending_command_.frames[index];
+    const std::size_t w = index / AXES_PER_WORD;
+    const uint64_t bit = uint64_t{1} << (index % AXES_PER_WORD);
+    if (same_command(pending, frame) && !(overridden_[w] & bit)) return;
+    pending = frame;
+    overridden_[w] &= ~bit;
+    staged_[w] |= bit;
+}
+
+void motor_manager::MotorManager::commit()
+{
+    bool staged{false};
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        if (!staged_[w]) continue;
+        staged = true;
+        for (auto& stale : stale_) stale[w] |= staged_[w];
+    }
+    if (!staged) return;
+
+    // The back slot may be any earlier one: copy every axis changed since it was last filled, not just this write's.
+    frame_block_t& back = command_.back();
+    std::vector<uint64_t>& stale = stale_[command_.back_index()];
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        for (uint64_t bits = stale[w]; bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            back.frames[i] = pending_command_.frames[i];
+        }
+        stale[w] = 0;
+    }
+    command_.publish();
+
+    // After publish(): a flag the RT loop sees always comes with (or after) the slot that carries the command.
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        if (!staged_[w]) continue;
+        dirty_[w].fetch_or(staged_[w], std::memory_order_release);
+        staged_[w] = 0;
+    }
+}
+
+uint8_t motor_manager::MotorManager::write(uint16_t controller_index, const waypoint_t* waypoints, uint8_t size)
+{
+    if (controller_index >= number_of_controllers_) return 0;
+
+    uint8_t queued{0};
+    while (queued < size && trajectories_[controller_index].push(waypoints[queued])) queued++;
+    return queued;
 }
 
 void motor_manager::MotorManager::read(motor_interface::motor_frame_t* status)
 {
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        status[i] = status_[i];
+    std::lock_guard<std::mutex> lock(read_mutex_);
+    status_.update();
+    const frame_block_t& block = status_.front();
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        status[i] = block.frames[i];
+    }
+}
+
+void motor_manager::MotorManager::read(motor_interface::motor_frame_t* status, bool* valid)
+{
+    std::lock_guard<std::mutex> lock(read_mutex_);
+    status_.update();
+    const frame_block_t& block = status_.front();
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        status[i] = block.frames[i];
+        valid[i] = block.valid[i] != 0;
     }
 }
 
+motor_manager::bus_health_t motor_manager::MotorManager::health()
+{
+    std::lock_guard<std::mutex> lock(health_mutex_);
+    health_.update();
+    return health_.front();
+}
+
+motor_manager::cycle_statistics_t motor_manager::MotorManager::statistics()
+{
+    std::lock_guard<std::mutex> lock(statistics_mutex_);
+    statistics_.update();
+    return statistics_.front();
+}
+
+std::future<motor_manager::sdo_result_t> motor_manager::MotorManager::read_sdo(
+    uint16_t controller_index,
+    uint16_t index,
+    uint8_t subindex)
+{
+    return sdo_.submit(controller_index, motor_interface::sdo_request_t{index, subindex, 0, false, 0});
+}
+
+std::future<motor_manager::sdo_result_t> motor_manager::MotorManager::write_sdo(
+    uint16_t controller_index,
+    uint16_t index,
+    uint8_t subindex,
+    uint8_t size,
+    uint32_t value)
+{
+    return sdo_.submit(controller_index, motor_interface::sdo_request_t{index, subindex, size, true, value});
+}
+
+bool motor_manager::MotorManager::submit_sdo(
+    uint16_t controller_index,
+    const motor_interface::sdo_request_t& request,
+    sdo_callback_t callback)
+{
+    return sdo_.submit(controller_index, request, std::move(callback));
+}
+
+void motor_manager::MotorManager::start_recording(const std::string& path)
+{
+    telemetry_.start(path, period_, number_of_controllers_);
+}
+
+bool motor_manager::MotorManager::reset_fault(uint16_t index)
+{
+    if (index >= number_of_controllers_) return false;
+    reset_requests_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+bool motor_manager::MotorManager::quick_stop(uint16_t index)
+{
+    if (index >= number_of_controllers_) return false;
+    requested_stops_[index].store(static_cast<uint8_t>(motor_interface::Cia402Goal::QuickStop), std::memory_order_relaxed);
+    stop_requests_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+bool motor_manager::MotorManager::halt(uint16_t index)
+{
+    if (index >= number_of_controllers_) return false;
+    requested_stops_[index].store(static_cast<uint8_t>(motor_interface::Cia402Goal::Halt), std::memory_order_relaxed);
+    stop_requests_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+bool motor_manager::MotorManager::resume(uint16_t index)
+{
+    if (index >= number_of_controllers_) return false;
+    requested_stops_[index].store(static_cast<uint8_t>(motor_interface::Cia402Goal::Enable), std::memory_order_relaxed);
+    stop_requests_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+bool motor_manager::MotorManager::set_mode(uint16_t index, motor_interface::OperationMode mode)
+{
+    if (index >= number_of_controllers_ || !motor_interface::isCyclicMode(static_cast<int8_t>(mode))) return false;
+    if (!(controllers_[index]->mapped() & (1u << motor_interface::ID_MODE_OF_OPERATION))) return false;
+    requested_modes_[index].store(static_cast<int8_t>(mode), std::memory_order_relaxed);
+    mode_requests_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+bool motor_manager::MotorManager::mode(uint16_t index, int8_t& mode)
+{
+    if (index >= number_of_controllers_) return false;
+    std::lock_guard<std::mutex> lock(read_mutex_);
+    status_.update();
+    mode = status_.front().modes[index];
+    return true;
+}
+
 void motor_manager::MotorManager::request_stop()
 {
     on_disabled_.store(true, std::memory_order_release);
@@ -192,21 +604,503 @@ void motor_manager::MotorManager::request_exit()
 
 void motor_manager::MotorManager::update()
 {
-    std::lock_guard<std::mutex> lock(frame_mutex_);
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        controllers_[i]->read(status_[i]);
-        controllers_[i]->check(status_[i]);
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        if (!data_valid_[m]) continue;  // keep the last valid status
+        for (uint16_t k = master_begin_[m]; k < master_begin_[m + 1]; ++k) {
+            const uint16_t i = controller_order_[k];
+            controllers_[i]->readCounts(rt_status_[i], status_lanes_);
+            if (displays_mode_[i]) displayed_modes_[i] = controllers_[i]->modeDisplay();
+        }
+    }
+
+    converter_.toSI(status_lanes_, number_of_controllers_);
+
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        rt_status_[i].position = status_lanes_.position[i];
+        rt_status_[i].velocity = status_lanes_.velocity[i];
+        rt_status_[i].torque = status_lanes_.torque[i];
+
+        uint16_t cw{0};
+        const uint8_t m = controller_master_[i];
+        if (!data_valid_[m] || rt_health_.masters[m].degraded || axis_states_[i] != AxisState::Healthy) continue;
+        if (received(dispatch_[i], rt_status_[i].statusword, cw)) controllers_[i]->writeControlword(cw);
     }
 
-    for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-        if (status_[i].errorcode != 0) return;
+    frame_block_t& published = status_.back();
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        published.frames[i] = rt_status_[i];
+        published.valid[i] = data_valid_[controller_master_[i]];
+        published.modes[i] = displayed_modes_[i];
     }
+    if (shm_.is_open()) shm_.publish(cycle_, published.frames.data(), published.valid.data(), published.modes.data());
+    status_.publish();
 
-    if (is_command_changed_.exchange(false, std::memory_order_acq_rel)) {
-        for (uint8_t i = 0; i < number_of_controllers_; ++i) {
-            controllers_[i]->write(command_[i]);
+    contain();
+    switchModes();
+    stopAxes();
+
+    // Flags before the slot: `commit()` publishes before flagging, so `front()` is at least as new as any flag taken.
+    for (std::size_t w = 0; w < dirty_words_; ++w) rt_fresh_[w] = dirty_[w].exchange(0, std::memory_order_acquire);
+    command_.update();
+    const frame_block_t& command = command_.front();
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        for (uint64_t bits = rt_fresh_[w]; bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            rt_commands_[i] = command.frames[i];
+        }
+        rt_dirty_[w] |= rt_fresh_[w];
+    }
+    if (shm_.is_open()) {
+        // Reported back to the writer: its next `write()` of these axes must not be dropped as unchanged.
+        std::fill(rt_foreign_.begin(), rt_foreign_.end(), 0);
+        shm_.take(rt_commands_.data(), rt_foreign_.data());
+        for (std::size_t w = 0; w < dirty_words_; ++w) {
+            if (!rt_foreign_[w]) continue;
+            rt_dirty_[w] |= rt_foreign_[w];
+            foreign_[w].fetch_or(rt_foreign_[w], std::memory_order_release);
         }
     }
+
+    bool dirty{false};
+    for (std::size_t w = 0; w < dirty_words_; ++w) dirty |= rt_dirty_[w] != 0;
+    if (dirty) apply();
+
+    follow();
+}
+
+void motor_manager::MotorManager::apply()
+{
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        for (uint64_t bits = rt_dirty_[w]; bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            command_lanes_.position[i] = rt_commands_[i].position;
+            command_lanes_.velocity[i] = rt_commands_[i].velocity;
+            command_lanes_.torque[i] = rt_commands_[i].torque;
+        }
+    }
+
+    converter_.toCounts(command_lanes_, number_of_controllers_);
+
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        uint64_t held{0};
+        for (uint64_t bits = rt_dirty_[w]; bits; bits &= bits - 1) {
+            const uint64_t bit = bits & (~bits + 1);
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            if (rt_health_.masters[controller_master_[i]].degraded || axis_states_[i] != AxisState::Healthy) {
+                held |= bit;  // hold the last command in the image; written once the master or axis recovers
+                continue;
+            }
+            controllers_[i]->writeCounts(rt_commands_[i], command_lanes_);
+            if (targets(rt_commands_[i], motor_interface::ID_TARGET_POSITION)) trajectories_[i].release();
+        }
+        rt_dirty_[w] = held;
+    }
+}
+
+void motor_manager::MotorManager::contain()
+{
+    bool changed{false};
+    uint16_t faulted{0};
+    uint16_t stopped{0};
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        AxisState& state = axis_states_[i];
+        if (state == AxisState::Healthy) {
+            if (rt_status_[i].errorcode == 0) continue;
+            state = AxisState::Faulted;
+            rt_health_.axis_faults++;
+            changed = true;
+        } else if (state == AxisState::Resetting) {
+            const uint8_t m = controller_master_[i];
+            if (data_valid_[m] && !rt_health_.masters[m].degraded && transition(i, motor_interface::Cia402Goal::Enable)) {
+                state = AxisState::Healthy;
+                rt_health_.fault_resets++;
+                changed = true;
+                continue;
+            }
+        } else if (state == AxisState::Switching) {
+            if (rt_status_[i].errorcode != 0) {
+                state = AxisState::Faulted;
+                rt_health_.axis_faults++;
+                changed = true;
+            } else if (displayed_modes_[i] == modes_[i]) {
+                state = AxisState::Healthy;
+                rt_health_.mode_switches++;
+                changed = true;
+                continue;
+            } else if (!data_valid_[controller_master_[i]] || ++mode_cycles_[i] < MODE_SWITCH_TIMEOUT) {
+                trajectories_[i].abort();
+                continue;
+            } else {
+                // The drive kept another mode: follow it when it is a cyclic one, otherwise treat the axis as faulted.
+                rt_health_.mode_timeouts++;
+                changed = true;
+                if (motor_interface::isCyclicMode(displayed_modes_[i])) {
+                    modes_[i] = displayed_modes_[i];
+                    controllers_[i]->writeMode(modes_[i]);
+                    state = AxisState::Healthy;
+                    continue;
+                }
+                state = AxisState::Faulted;
+                rt_health_.axis_faults++;
+            }
+        } else if (state == AxisState::Stopped) {
+            const uint8_t m = controller_master_[i];
+            if (rt_status_[i].errorcode != 0) {
+                state = AxisState::Faulted;
+                rt_health_.axis_faults++;
+                changed = true;
+            } else {
+                const motor_interface::Cia402Goal goal = stop_goals_[i];
+                if (data_valid_[m] && !rt_health_.masters[m].degraded && hold(i, goal) && goal == motor_interface::Cia402Goal::Enable) {
+                    state = AxisState::Healthy;
+                    rt_health_.axis_resumes++;
+                    changed = true;
+                    continue;
+                }
+                trajectories_[i].abort();
+                stopped++;
+                continue;
+            }
+        }
+        trajectories_[i].abort();  // waypoints queued while the axis is not healthy are dropped
+        faulted++;
+    }
+
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        for (uint64_t bits = reset_requests_[w].exchange(0, std::memory_order_acquire); bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            const AxisState state = axis_states_[i];
+            if (state == AxisState::Healthy || state == AxisState::Switching || state == AxisState::Stopped) continue;
+            axis_states_[i] = AxisState::Resetting;
+            cia402_axes_[i] = motor_interface::cia402_axis_t{};
+
+            // Target the measured position so the axis does not jump when enabled; the enable walk starts next
+            // cycle, after a cleared controlword gives the fault reset bit its rising edge.
+            command_lanes_.position[i] = rt_status_[i].position;
+            command_lanes_.position_count[i] = status_lanes_.position_count[i];
+            controllers_[i]->writeCounts(trajectory_frame_, command_lanes_);
+            controllers_[i]->writeControlword(0);
+        }
+    }
+
+    if (!changed && faulted == rt_health_.faulted_axes && stopped == rt_health_.stopped_axes) return;
+    rt_health_.faulted_axes = faulted;
+    rt_health_.stopped_axes = stopped;
+    health_.back() = rt_health_;
+    health_.publish();
+}
+
+void motor_manager::MotorManager::switchModes()
+{
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        rt_mode_requests_[w] |= mode_requests_[w].exchange(0, std::memory_order_acquire);
+        for (uint64_t bits = rt_mode_requests_[w]; bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            const uint8_t m = controller_master_[i];
+            const AxisState state = axis_states_[i];
+            if ((state != AxisState::Healthy && state != AxisState::Switching) || !data_valid_[m] || rt_health_.masters[m].degraded) continue;
+            rt_mode_requests_[w] &= ~(uint64_t{1} << (i % AXES_PER_WORD));
+
+            const int8_t mode = requested_modes_[i].load(std::memory_order_relaxed);
+            if (mode == modes_[i] && state == AxisState::Healthy) continue;
+            modes_[i] = mode;
+            if (!displays_mode_[i]) displayed_modes_[i] = mode;
+
+            // Bumpless: the new mode's target starts at the measured value, written in the same frame as the mode.
+            writeMeasured(static_cast<uint16_t>(i));
+            controllers_[i]->writeMode(mode);
+
+            trajectories_[i].abort();
+            mode_cycles_[i] = 0;
+            axis_states_[i] = AxisState::Switching;
+        }
+    }
+}
+
+void motor_manager::MotorManager::stopAxes()
+{
+    for (std::size_t w = 0; w < dirty_words_; ++w) {
+        rt_stop_requests_[w] |= stop_requests_[w].exchange(0, std::memory_order_acquire);
+        for (uint64_t bits = rt_stop_requests_[w]; bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            const uint8_t m = controller_master_[i];
+            const AxisState state = axis_states_[i];
+            if ((state != AxisState::Healthy && state != AxisState::Stopped) || !data_valid_[m] || rt_health_.masters[m].degraded) continue;
+            rt_stop_requests_[w] &= ~(uint64_t{1} << (i % AXES_PER_WORD));
+
+            const auto goal = static_cast<motor_interface::Cia402Goal>(requested_stops_[i].load(std::memory_order_relaxed));
+            if (goal == motor_interface::Cia402Goal::Enable) {
+                if (state != AxisState::Stopped) continue;  // nothing to resume
+                // Enabled again from where the drive stopped, not toward the target it held before.
+                writeMeasured(static_cast<uint16_t>(i));
+            } else if (state == AxisState::Healthy || stop_goals_[i] != goal) {
+                rt_health_.axis_stops++;
+            }
+
+            stop_goals_[i] = goal;
+            cia402_axes_[i] = motor_interface::cia402_axis_t{};
+            trajectories_[i].abort();
+            axis_states_[i] = AxisState::Stopped;
+        }
+    }
+}
+
+void motor_manager::MotorManager::follow()
+{
+    constexpr int8_t csp = static_cast<int8_t>(motor_interface::OperationMode::CyclicSyncPosition);
+    bool any{false};
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        if (modes_[i] != csp) {
+            trajectories_[i].abort();  // waypoints are position set-points
+            following_[i] = 0;
+            continue;
+        }
+        following_[i] = axis_states_[i] == AxisState::Healthy &&
+            trajectories_[i].sample(monotonic_time_, rt_status_[i].position, command_lanes_.position[i], command_lanes_.velocity[i]);
+        any |= following_[i] != 0;
+    }
+    if (!any) return;
+
+    converter_.toCounts(command_lanes_, number_of_controllers_);
+
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        if (rt_health_.masters[m].degraded) continue;
+        for (uint16_t k = master_begin_[m]; k < master_begin_[m + 1]; ++k) {
+            const uint16_t i = controller_order_[k];
+            if (following_[i]) controllers_[i]->writeCounts(trajectory_frame_, command_lanes_);
+        }
+    }
+}
+
+bool motor_manager::MotorManager::control(uint64_t cycle)
+{
+    if (is_disabled_) {
+        return false;
+    } else if (on_disabled_.load(std::memory_order_acquire)) {
+        disable();
+    } else if (!is_enable_) {
+        enable();
+    } else {
+        update();
+    }
+    sdo_.process(controllers_.data(), number_of_controllers_);
+    capture(cycle);
+    return true;
+}
+
+bool motor_manager::MotorManager::step(uint64_t application_time, uint64_t monotonic_time)
+{
+    const timespec time{
+        static_cast<time_t>(application_time / NSEC_PER_SEC),
+        static_cast<long>(application_time % NSEC_PER_SEC)};
+
+    for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->apply_application_time(time);
+    for (uint8_t m = 0; m < number_of_masters_; ++m) receive_results_[m] = masters_[m]->receive();
+    monitor();
+    if (clock_sync_ && cycle_ && data_valid_[sync_master_]) correction_ = synchronize(cycle_time_);
+    cycle_time_ = application_time;
+    monotonic_time_ = monotonic_time ? monotonic_time : application_time;
+
+    if (!control(cycle_)) return false;
+    if (++rt_statistics_.cycles % STATISTICS_PUBLISH_CYCLES == 0) {
+        statistics_.back() = rt_statistics_;
+        statistics_.publish();
+    }
+
+    schedule(cycle_++);
+    for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->save_clock();
+    for (uint8_t m = 0; m < number_of_masters_; ++m) transmit_results_[m] = masters_[m]->transmit();
+    return true;
+}
+
+void motor_manager::MotorManager::capture(uint64_t cycle)
+{
+    const uint32_t session = telemetry_.session();
+    if (!session) return;
+
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        telemetry_sample_t sample{};
+        sample.cycle = cycle;
+        sample.time = cycle_time_;
+        sample.command_position = command_lanes_.position[i];
+        sample.command_velocity = command_lanes_.velocity[i];
+        sample.command_torque = command_lanes_.torque[i];
+        sample.position = rt_status_[i].position;
+        sample.velocity = rt_status_[i].velocity;
+        sample.torque = rt_status_[i].torque;
+        sample.controlword = controllers_[i]->controlword();
+        sample.statusword = rt_status_[i].statusword;
+        sample.errorcode = rt_status_[i].errorcode;
+        sample.axis = i;
+        sample.valid = data_valid_[controller_master_[i]];
+        sample.mode = modes_[i];
+        sample.mode_display = displayed_modes_[i];
+        const motor_interface::motor_frame_t& command = rt_commands_[i];
+        const uint8_t n = std::min(command.number_of_target_interfaces, motor_interface::MAX_INTERFACE_SIZE);
+        for (uint8_t k = 0; k < n; ++k) {
+            const uint8_t id = command.target_interface_id[k];
+            if (id <= motor_interface::ID_TARGET_TORQUE) sample.targets |= static_cast<uint8_t>(1u << id);
+        }
+        telemetry_.record(session, sample);
+    }
+}
+
+void motor_manager::MotorManager::monitor()
+{
+    bool changed{false};
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        master_health_t& health = rt_health_.masters[m];
+        const int transmitted = transmit_results_[m];
+        const int received = receive_results_[m];
+        transmit_results_[m] = 0;
+
+        if (transmitted != 0) {
+            health.transmit_errors++;
+            health.last_error = transmitted;
+        }
+        if (received != 0) {
+            health.receive_errors++;
+            health.last_error = received;
+        }
+
+        const motor_interface::DataState state =
+            received != 0 ? motor_interface::DataState::Zero : masters_[m]->data_state();
+        data_valid_[m] = state == motor_interface::DataState::Complete;
+        if (received == 0 && !data_valid_[m]) {
+            health.wkc_mismatches++;
+            if (state == motor_interface::DataState::Incomplete) health.incomplete_domains++;
+        }
+
+        const bool link_up = masters_[m]->link_up();
+        if (link_up != health.link_up) {
+            if (!link_up) health.link_down_events++;
+            health.link_up = link_up;
+            changed = true;
+        }
+
+        if (transmitted != 0 || !data_valid_[m]) {
+            health.consecutive_errors++;
+            if (health.consecutive_errors >= max_consecutive_errors_) health.degraded = true;
+            changed = true;
+        } else if (health.consecutive_errors != 0) {
+            health.consecutive_errors = 0;
+            health.degraded = false;
+            changed = true;
+        }
+        if (health.degraded) health.degraded_cycles++;
+    }
+
+    if (!changed) return;
+
+    uint64_t invalid_interfaces{0};
+    for (uint16_t i = 0; i < number_of_controllers_; ++i) {
+        invalid_interfaces += controllers_[i]->invalid_interface_count();
+    }
+    rt_health_.invalid_interfaces = invalid_interfaces;
+    health_.back() = rt_health_;
+    health_.publish();
+}
+
+void motor_manager::MotorManager::schedule(uint64_t cycle)
+{
+    for (uint8_t m = 0; m < number_of_masters_; ++m) {
+        motor_interface::MotorMaster& master = *masters_[m];
+        uint8_t due{0};
+        for (uint8_t d = 0; d < master.number_of_domains(); ++d) {
+            if (cycle % master.divider(d) == 0) due |= static_cast<uint8_t>(1u << d);
+        }
+        master.schedule(due);
+    }
+}
+
+int64_t motor_manager::MotorManager::synchronize(uint64_t previous_application_time)
+{
+    uint32_t reference{0};
+    if (!masters_[sync_master_]->reference_clock_time(reference)) return 0;
+
+    const int32_t offset = static_cast<int32_t>(reference - static_cast<uint32_t>(previous_application_time));
+    const int64_t correction = drift_.update(offset);
+
+    clock_sync_statistics_t& sync = rt_statistics_.clock_sync;
+    const uint32_t magnitude = offset < 0 ? 0u - static_cast<uint32_t>(offset) : static_cast<uint32_t>(offset);
+    sync.offset = offset;
+    if (magnitude > sync.max_offset) sync.max_offset = magnitude;
+    sync.correction = correction;
+    sync.drift_ppm = drift_.drift_ppm();
+    return correction;
+}
+
+void motor_manager::MotorManager::record(
+    const timespec& wakeup,
+    const timespec& woken,
+    const timespec& received,
+    const timespec& updated,
+    const timespec& saved,
+    const timespec& transmitted)
+{
+    if (statistics_reset_.exchange(false, std::memory_order_acq_rel)) {
+        rt_statistics_ = cycle_statistics_t{};
+    }
+
+    rt_statistics_.phase(CyclePhase::Wakeup).record(elapsed(wakeup, woken));
+    rt_statistics_.phase(CyclePhase::Receive).record(elapsed(woken, received));
+    rt_statistics_.phase(CyclePhase::Update).record(elapsed(received, updated));
+    rt_statistics_.phase(CyclePhase::SaveClock).record(elapsed(updated, saved));
+    rt_statistics_.phase(CyclePhase::Transmit).record(elapsed(saved, transmitted));
+
+    const uint64_t cycle = elapsed(wakeup, transmitted);
+    rt_statistics_.phase(CyclePhase::Cycle).record(cycle);
+    if (cycle > period_) rt_statistics_.overruns++;
+
+    if (++rt_statistics_.cycles % STATISTICS_PUBLISH_CYCLES == 0) {
+        statistics_.back() = rt_statistics_;
+        statistics_.publish();
+    }
+}
+
+motor_manager::thread_config_t motor_manager::MotorManager::masterThreadConfig(uint8_t m_slot) const
+{
+    thread_config_t config = rt_config_;
+    if (master_cpus_[m_slot] >= 0) config.cpus = {master_cpus_[m_slot]};
+    return config;
+}
+
+std::string motor_manager::MotorManager::placement_report() const
+{
+    std::string report = placementReport("run", rt_config_);
+    if (parallel_masters_ && number_of_masters_ > 1) {
+        for (uint8_t m = 0; m < number_of_masters_; ++m) {
+            report += placementReport("master " + std::to_string(m), masterThreadConfig(m));
+        }
+    }
+    return report;
+}
+
+void motor_manager::MotorManager::runMaster(
+    uint8_t m_slot,
+    const thread_config_t& config,
+    CycleBarrier& barrier,
+    std::exception_ptr& error)
+{
+    motor_interface::MotorMaster& master = *masters_[m_slot];
+    try {
+        applyThreadConfig(config);
+        stack_prefault();
+
+        while (barrier.arrive_and_wait()) {
+            master.apply_application_time(cycle_application_time_);
+            receive_results_[m_slot] = master.receive();
+            if (!barrier.arrive_and_wait()) break;
+
+            if (!barrier.arrive_and_wait()) break;
+            master.save_clock();
+            transmit_results_[m_slot] = master.transmit();
+            if (!barrier.arrive_and_wait()) break;
+        }
+    } catch (...) {
+        error = std::current_exception();
+        barrier.cancel();
+    }
 }
 
 void motor_manager::MotorManager::run()
@@ -224,13 +1118,45 @@ void motor_manager::MotorManager::run()
         throw std::runtime_error("Failed to lock memory (mlockall).");
     }
 
-    struct sched_param param = {};
-    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    const bool parallel = parallel_masters_ && number_of_masters_ > 1;
+    CycleBarrier barrier(
+        parallel ? static_cast<uint32_t>(number_of_masters_ + 1) : 1,
+        std::thread::hardware_concurrency() > 1 ? BARRIER_SPIN : 0);
+    std::vector<std::thread> workers;
+    std::exception_ptr errors[MAX_MASTER_SIZE];
+    thread_config_t master_configs[MAX_MASTER_SIZE];
+
+    struct worker_guard_t {
+        CycleBarrier& barrier;
+        std::vector<std::thread>& workers;
+
+        void join()
+        {
+            barrier.cancel();
+            for (auto& w : workers) if (w.joinable()) w.join();
+        }
+
+        ~worker_guard_t() { join(); }
+    } guard{barrier, workers};
+
+    // Spawned before this thread switches policy: a SCHED_DEADLINE thread cannot create threads.
+    if (parallel) {
+        workers.reserve(number_of_masters_);
+        for (uint8_t m = 0; m < number_of_masters_; ++m) {
+            master_configs[m] = masterThreadConfig(m);
+            workers.emplace_back(&MotorManager::runMaster, this, m,
+                std::cref(master_configs[m]), std::ref(barrier), std::ref(errors[m]));
+        }
+    }
+
+    std::fputs(placement_report().c_str(), stderr);
 
-    if (sched_setscheduler(0, SCHED_FIFO, &param) == -1) {
+    try {
+        applyThreadConfig(rt_config_);
+    } catch (...) {
         unlock_memory();
         stop();
-        throw std::runtime_error("Failed to set scheduler.");
+        throw;
     }
 
     if (mlockall(MCL_CURRENT | MCL_FUTURE) == -1) {
@@ -241,10 +1167,6 @@ void motor_manager::MotorManager::run()
 
     stack_prefault();
 
-    timespec cycle_time{};
-    cycle_time.tv_sec = static_cast<time_t>(period_ / NSEC_PER_SEC);
-    cycle_time.tv_nsec = static_cast<long>(period_ % NSEC_PER_SEC);
-
     timespec wakeup_time{};
     if (clock_gettime(CLOCK_MONOTONIC, &wakeup_time) == -1) {
         unlock_memory();
@@ -252,12 +1174,14 @@ void motor_manager::MotorManager::run()
         throw std::runtime_error("clock_gettime failed.");
     }
 
+    // Application time advances by exactly one period; with `clock_sync` the monotonic wakeup absorbs the drift.
+    timespec application_time = wakeup_time;
+    uint64_t previous_application_time{0};
+
+    timespec woken{}, received{}, updated{}, saved{}, transmitted{};
     while (running_.load(std::memory_order_acquire)) {
-        wakeup_time.tv_nsec += cycle_time.tv_nsec;
-        while (wakeup_time.tv_nsec >= NSEC_PER_SEC) {
-            wakeup_time.tv_sec++;
-            wakeup_time.tv_nsec -= NSEC_PER_SEC;
-        }
+        advance(wakeup_time, static_cast<int64_t>(period_) + correction_);
+        advance(application_time, static_cast<int64_t>(period_));
 
         int sleep_rc;
         do {
@@ -265,30 +1189,58 @@ void motor_manager::MotorManager::run()
         } while (sleep_rc == EINTR);
 
         if (sleep_rc != 0) {
+            guard.join();
             unlock_memory();
             stop();
             throw std::runtime_error("clock_nanosleep failed.");
         }
+        now(woken);
+
+        if (parallel) {
+            cycle_application_time_ = application_time;
+            if (!barrier.arrive_and_wait() || !barrier.arrive_and_wait()) break;
+        } else {
+            for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->apply_application_time(application_time);
 
-        for (auto& m_iter : masters_) m_iter.second->apply_application_time(wakeup_time);
+            for (uint8_t m = 0; m < number_of_masters_; ++m) receive_results_[m] = masters_[m]->receive();
+        }
+        monitor();
+        if (clock_sync_ && previous_application_time && data_valid_[sync_master_]) correction_ = synchronize(previous_application_time);
+        previous_application_time = nanoseconds(application_time);
+        cycle_time_ = previous_application_time;
+        monotonic_time_ = nanoseconds(wakeup_time);
+        now(received);
 
-        for (auto& m_iter : masters_) m_iter.second->receive();
+        if (!control(cycle_)) break;
+        now(updated);
 
-        if (is_disabled_) {
-            break;
-        } else if (on_disabled_.load(std::memory_order_acquire)) {
-            disable();
-        } else if (!is_enable_) {
-            enable();
+        schedule(cycle_++);
+        if (parallel) {
+            if (!barrier.arrive_and_wait() || !barrier.arrive_and_wait()) break;
+            saved = updated;
         } else {
-            update();
-        }
+            for (uint8_t m = 0; m < number_of_masters_; ++m) masters_[m]->save_clock();
+            now(saved);
 
-        for (auto& m_iter : masters_) m_iter.second->save_clock();
+            for (uint8_t m = 0; m < number_of_masters_; ++m) transmit_results_[m] = masters_[m]->transmit();
+        }
+        now(transmitted);
 
-        for (auto& m_iter : masters_) m_iter.second->transmit();
+        record(wakeup_time, woken, received, updated, saved, transmitted);
     }
 
+    guard.join();
+    sdo_.cancel();
+
+    statistics_.back() = rt_statistics_;
+    statistics_.publish();
+    health_.back() = rt_health_;
+    health_.publish();
+
     unlock_memory();
     stop();
+
+    for (const auto& error : errors) {
+        if (error) std::rethrow_exception(error);
+    }
 }
@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#include <sched.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include "motor_manager/realtime.hpp"
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+namespace {
+
+/** Layout of `struct sched_attr` (linux/sched/types.h); glibc only wraps `sched_setattr` since 2.41. */
+struct sched_attr_t {
+    uint32_t size;
+    uint32_t sched_policy;
+    uint64_t sched_flags;
+    int32_t sched_nice;
+    uint32_t sched_priority;
+    uint64_t sched_runtime;
+    uint64_t sched_deadline;
+    uint64_t sched_period;
+};
+
+void apply_affinity(const std::vector<int>& cpus)
+{
+    if (cpus.empty()) return;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : cpus) {
+        if (cpu < 0 || cpu >= CPU_SETSIZE) throw std::runtime_error("Invalid CPU index.");
+        CPU_SET(cpu, &set);
+    }
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        throw std::runtime_error("Failed to set CPU affinity.");
+    }
+}
+
+void apply_deadline(const motor_manager::thread_config_t& config)
+{
+    sched_attr_t attr{};
+    attr.size = sizeof(attr);
+    attr.sched_policy = SCHED_DEADLINE;
+    attr.sched_period = config.period;
+    attr.sched_deadline = config.deadline ? config.deadline : config.period;
+    attr.sched_runtime = config.runtime ? config.runtime : config.period / 2;
+
+    if (syscall(SYS_sched_setattr, 0, &attr, 0) == -1) {
+        throw std::runtime_error(
+            "Failed to set SCHED_DEADLINE (runtime <= deadline <= period required; "
+            "restricted cpus need an exclusive cpuset).");
+    }
+}
+
+std::string join(const std::vector<int>& cpus)
+{
+    if (cpus.empty()) return "any";
+
+    std::ostringstream out;
+    for (std::size_t i = 0; i < cpus.size(); ++i) {
+        if (i) out << ',';
+        out << cpus[i];
+    }
+    return out.str();
+}
+
+bool contains(const std::vector<int>& cpus, int cpu)
+{
+    return std::find(cpus.begin(), cpus.end(), cpu) != cpus.end();
+}
+
+} // namespace
+
+void motor_manager::applyThreadConfig(const thread_config_t& config)
+{
+    apply_affinity(config.cpus);
+
+    switch (config.policy) {
+    case SchedulingPolicy::Fifo:
+    case SchedulingPolicy::RoundRobin: {
+        const int policy = config.policy == SchedulingPolicy::Fifo ? SCHED_FIFO : SCHED_RR;
+        struct sched_param param = {};
+        param.sched_priority = config.priority ? config.priority : sched_get_priority_max(policy);
+        if (pthread_setschedparam(pthread_self(), policy, &param) != 0) {
+            throw std::runtime_error("Failed to set scheduler.");
+        }
+        break;
+    } case SchedulingPolicy::Deadline: {
+        apply_deadline(config);
+        break;
+    }
+    }
+}
+
+std::vector<int> motor_manager::parseCpuList(const std::string& list)
+{
+    std::vector<int> cpus;
+    std::istringstream in(list);
+    std::string range;
+    while (std::getline(in, range, ',')) {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) continue;
+
+        const std::size_t dash = range.find('-');
+        try {
+            const int first = std::stoi(range.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+            if (first < 0 || last < first) throw std::invalid_argument(range);
+            for (int cpu = first; cpu <= last; ++cpu) {
+                if (!contains(cpus, cpu)) cpus.push_back(cpu);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Invalid CPU list.");
+        }
+    }
+    return cpus;
+}
+
+std::vector<int> motor_manager::readCpuList(const char* path)
+{
+    std::ifstream file(path);
+    std::string list;
+    if (!file || !std::getline(file, list)) return {};
+    try {
+        return parseCpuList(list);
+    } catch (const std::runtime_error&) {
+        return {};  // e.g. "(null)" when the feature is not configured
+    }
+}
+
+std::string motor_manager::placementReport(const std::string& name, const thread_config_t& config)
+{
+    std::ostringstream out;
+    out << "[motor_manager] " << name << ": policy=" << toString(config.policy);
+    if (config.policy == SchedulingPolicy::Deadline) {
+        out << " runtime=" << (config.runtime ? config.runtime : config.period / 2)
+            << " deadline=" << (config.deadline ? config.deadline : config.period)
+            << " period=" << config.period;
+    } else if (config.priority) {
+        out << " priority=" << config.priority;
+    } else {
+        out << " priority=max";
+    }
+    out << " cpus=" << join(config.cpus) << '\n';
+
+    if (config.cpus.empty()) {
+        out << "[motor_manager]   warning: not pinned; may share a CPU with IRQ and housekeeping threads\n";
+        return out.str();
+    }
+
+    const std::vector<int> isolated = readCpuList(ISOLATED_CPUS_PATH);
+    const std::vector<int> nohz_full = readCpuList(NOHZ_FULL_CPUS_PATH);
+    for (int cpu : config.cpus) {
+        if (!contains(isolated, cpu)) {
+            out << "[motor_manager]   warning: cpu " << cpu << " is not in isolcpus\n";
+        }
+        if (!contains(nohz_full, cpu)) {
+            out << "[motor_manager]   warning: cpu " << cpu << " is not in nohz_full\n";
+        }
+    }
+    return out.str();
+}
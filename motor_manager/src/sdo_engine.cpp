@@ -0,0 +1,175 @@
+#include <cerrno>
+#include <chrono>
+
+#include "motor_manager/sdo_engine.hpp"
+
+namespace {
+
+std::future<motor_manager::sdo_result_t> ready(int error)
+{
+    std::promise<motor_manager::sdo_result_t> promise;
+    promise.set_value(motor_manager::sdo_result_t{error, 0});
+    return promise.get_future();
+}
+
+bool valid(const motor_interface::sdo_request_t& request)
+{
+    return !request.write || request.size == 1 || request.size == 2 || request.size == 4;
+}
+
+} // namespace
+
+motor_manager::SdoEngine::SdoEngine()
+{
+    for (uint8_t s = 0; s < SDO_POOL_SIZE; ++s) free_.push(s);
+
+    completion_ = std::thread(&SdoEngine::runCompletion, this);
+}
+
+motor_manager::SdoEngine::~SdoEngine()
+{
+    stop_.store(true, std::memory_order_release);
+    if (completion_.joinable()) completion_.join();
+
+    cancel();
+    uint8_t slot;
+    while (completed_.pop(slot)) deliver(slot);
+}
+
+std::future<motor_manager::sdo_result_t> motor_manager::SdoEngine::submit(
+    uint16_t controller_index,
+    const motor_interface::sdo_request_t& request)
+{
+    if (!valid(request)) return ready(-EINVAL);
+
+    const uint8_t slot = acquire(controller_index, request);
+    if (slot == NO_SLOT) return ready(-EAGAIN);
+
+    slots_[slot].promise = std::promise<sdo_result_t>();
+    std::future<sdo_result_t> future = slots_[slot].promise.get_future();
+    submitted_.push(slot);
+    return future;
+}
+
+bool motor_manager::SdoEngine::submit(
+    uint16_t controller_index,
+    const motor_interface::sdo_request_t& request,
+    sdo_callback_t callback)
+{
+    if (!valid(request) || !callback) return false;
+
+    const uint8_t slot = acquire(controller_index, request);
+    if (slot == NO_SLOT) return false;
+
+    slots_[slot].callback = std::move(callback);
+    submitted_.push(slot);
+    return true;
+}
+
+void motor_manager::SdoEngine::process(
+    std::unique_ptr<motor_interface::MotorController>* controllers,
+    uint16_t number_of_controllers)
+{
+    uint8_t budget = SDO_BUDGET;
+
+    // Round robin over busy channels so a slow slave cannot starve the others of polls.
+    for (uint16_t k = 0; k < number_of_controllers && budget > 0; ++k) {
+        const uint16_t i = static_cast<uint16_t>((poll_cursor_ + k) % number_of_controllers);
+        const uint8_t slot = in_flight_[i];
+        if (slot == NO_SLOT) continue;
+
+        budget--;
+        uint32_t value{0};
+        const motor_interface::SdoState state = controllers[i]->pollSdo(value);
+        if (state == motor_interface::SdoState::Busy) continue;
+
+        in_flight_[i] = NO_SLOT;
+        if (slot != ORPHANED_SLOT) complete(slot, state == motor_interface::SdoState::Done ? 0 : -EIO, value);
+    }
+    if (number_of_controllers) poll_cursor_ = static_cast<uint16_t>((poll_cursor_ + 1) % number_of_controllers);
+
+    uint8_t slot;
+    while (backlog_size_ < SDO_POOL_SIZE && submitted_.pop(slot)) backlog_[backlog_size_++] = slot;
+
+    // One pass in FIFO order: per channel, only the oldest waiting transfer can start.
+    uint8_t kept{0};
+    for (uint8_t k = 0; k < backlog_size_; ++k) {
+        const uint8_t s = backlog_[k];
+        const uint16_t i = slots_[s].controller_index;
+        if (i >= number_of_controllers) {
+            complete(s, -EINVAL);
+            continue;
+        }
+        if (budget == 0 || in_flight_[i] != NO_SLOT) {
+            backlog_[kept++] = s;
+            continue;
+        }
+
+        budget--;
+        if (controllers[i]->startSdo(slots_[s].request)) {
+            in_flight_[i] = s;
+        } else {
+            complete(s, -ENOTSUP);
+        }
+    }
+    backlog_size_ = kept;
+}
+
+void motor_manager::SdoEngine::cancel()
+{
+    for (std::size_t i = 0; i < in_flight_.size(); ++i) {
+        if (in_flight_[i] == NO_SLOT || in_flight_[i] == ORPHANED_SLOT) continue;
+        complete(in_flight_[i], -ECANCELED);
+        in_flight_[i] = ORPHANED_SLOT;
+    }
+
+    for (uint8_t k = 0; k < backlog_size_; ++k) complete(backlog_[k], -ECANCELED);
+    backlog_size_ = 0;
+
+    uint8_t slot;
+    while (submitted_.pop(slot)) complete(slot, -ECANCELED);
+}
+
+uint8_t motor_manager::SdoEngine::acquire(uint16_t controller_index, const motor_interface::sdo_request_t& request)
+{
+    uint8_t slot;
+    if (!free_.pop(slot)) return NO_SLOT;
+
+    slots_[slot].controller_index = controller_index;
+    slots_[slot].request = request;
+    return slot;
+}
+
+void motor_manager::SdoEngine::complete(uint8_t slot, int error, uint32_t value)
+{
+    slots_[slot].result = sdo_result_t{error, value};
+    completed_.push(slot);  // capacity is the pool size: never full
+}
+
+void motor_manager::SdoEngine::deliver(uint8_t slot)
+{
+    sdo_slot_t& s = slots_[slot];
+    if (s.callback) {
+        try {
+            s.callback(s.result);
+        } catch (...) {
+            // A throwing callback must not take the completion thread down.
+        }
+        s.callback = nullptr;
+    } else {
+        s.promise.set_value(s.result);
+    }
+    free_.push(slot);
+}
+
+void motor_manager::SdoEngine::runCompletion()
+{
+    while (!stop_.load(std::memory_order_acquire)) {
+        uint8_t slot;
+        if (completed_.pop(slot)) {
+            deliver(slot);
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(SDO_COMPLETION_POLL));
+    }
+}
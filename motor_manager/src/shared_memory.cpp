@@ -0,0 +1,221 @@
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "motor_manager/shared_memory.hpp"
+
+namespace {
+
+constexpr std::size_t AXES_PER_WORD = 64;
+
+/** Byte offsets of a segment for `n` axes; every block starts on its own cache line. */
+struct layout_t {
+    std::size_t pending;
+    std::size_t status;
+    std::size_t commands;
+    std::size_t size;
+};
+
+constexpr std::size_t align(std::size_t offset)
+{
+    return (offset + motor_manager::CACHE_LINE_SIZE - 1) / motor_manager::CACHE_LINE_SIZE * motor_manager::CACHE_LINE_SIZE;
+}
+
+constexpr std::size_t words(uint16_t n)
+{
+    return (n + AXES_PER_WORD - 1) / AXES_PER_WORD;
+}
+
+layout_t layout(uint16_t n)
+{
+    layout_t l{};
+    l.pending = align(sizeof(motor_manager::shm_header_t));
+    l.status = align(l.pending + words(n) * sizeof(std::atomic<uint64_t>));
+    l.commands = align(l.status + sizeof(motor_manager::shm_status_t) + n * sizeof(motor_manager::shm_axis_status_t));
+    l.size = l.commands + n * sizeof(motor_manager::shm_command_t);
+    return l;
+}
+
+} // namespace
+
+void motor_manager::SharedMemoryServer::open(const std::string& name, uint32_t period, uint16_t number_of_controllers)
+{
+    if (is_open()) throw std::runtime_error("Shared memory is already open.");
+
+    const layout_t l = layout(number_of_controllers);
+    shm_unlink(name.c_str());  // a segment left behind by a crashed run
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0660);
+    if (fd == -1) throw std::runtime_error("Failed to create shared memory.");
+    if (ftruncate(fd, static_cast<off_t>(l.size)) == -1) {
+        ::close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to size shared memory.");
+    }
+
+    void* data = mmap(nullptr, l.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to map shared memory.");
+    }
+
+    uint8_t* base = static_cast<uint8_t*>(data);
+    name_ = name;
+    words_ = words(number_of_controllers);
+    header_ = new (base) shm_header_t{};
+    pending_ = reinterpret_cast<std::atomic<uint64_t>*>(base + l.pending);
+    for (std::size_t w = 0; w < words_; ++w) new (&pending_[w]) std::atomic<uint64_t>(0);
+    status_ = new (base + l.status) shm_status_t{};
+    axes_ = reinterpret_cast<shm_axis_status_t*>(base + l.status + sizeof(shm_status_t));
+    commands_ = reinterpret_cast<shm_command_t*>(base + l.commands);
+    for (uint16_t i = 0; i < number_of_controllers; ++i) new (&commands_[i]) shm_command_t{};
+
+    header_->version = SHM_VERSION;
+    header_->period = period;
+    header_->number_of_controllers = number_of_controllers;
+    header_->status_size = sizeof(shm_axis_status_t);
+    header_->command_size = sizeof(shm_command_t);
+    header_->pending_offset = l.pending;
+    header_->status_offset = l.status;
+    header_->command_offset = l.commands;
+    header_->size = l.size;
+    std::atomic_thread_fence(std::memory_order_release);
+    header_->magic = SHM_MAGIC;  // last: a client that sees it sees the rest
+}
+
+void motor_manager::SharedMemoryServer::close()
+{
+    if (!is_open()) return;
+    munmap(header_, header_->size);
+    shm_unlink(name_.c_str());
+    header_ = nullptr;
+    pending_ = nullptr;
+    status_ = nullptr;
+    axes_ = nullptr;
+    commands_ = nullptr;
+    words_ = 0;
+}
+
+void motor_manager::SharedMemoryServer::publish(
+    uint64_t cycle,
+    const motor_interface::motor_frame_t* frames,
+    const uint8_t* valid,
+    const int8_t* modes)
+{
+    const uint64_t sequence = status_->sequence.load(std::memory_order_relaxed);
+    status_->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    status_->cycle = cycle;
+    for (uint16_t i = 0; i < header_->number_of_controllers; ++i) {
+        axes_[i].frame = frames[i];
+        axes_[i].valid = valid[i];
+        axes_[i].mode = modes[i];
+    }
+    status_->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void motor_manager::SharedMemoryServer::take(motor_interface::motor_frame_t* commands, uint64_t* dirty)
+{
+    for (std::size_t w = 0; w < words_; ++w) {
+        for (uint64_t bits = pending_[w].exchange(0, std::memory_order_acquire); bits; bits &= bits - 1) {
+            const std::size_t i = w * AXES_PER_WORD + static_cast<std::size_t>(__builtin_ctzll(bits));
+            const shm_command_t& slot = commands_[i];
+            const uint32_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence & 1u) continue;
+
+            const motor_interface::motor_frame_t frame = slot.frame;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+            commands[i] = frame;
+            dirty[w] |= bits & (~bits + 1);
+        }
+    }
+}
+
+void motor_manager::SharedMemoryClient::open(const std::string& name)
+{
+    close();
+
+    const int fd = shm_open(name.c_str(), O_RDWR | O_CLOEXEC, 0);
+    if (fd == -1) throw std::runtime_error("Failed to open shared memory.");
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || static_cast<std::size_t>(info.st_size) < sizeof(shm_header_t)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid shared memory.");
+    }
+
+    length_ = static_cast<std::size_t>(info.st_size);
+    void* data = mmap(nullptr, length_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) throw std::runtime_error("Failed to map shared memory.");
+
+    uint8_t* base = static_cast<uint8_t*>(data);
+    header_ = reinterpret_cast<const shm_header_t*>(base);
+    const bool valid = header_->magic == SHM_MAGIC;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (!valid ||
+        header_->version != SHM_VERSION ||
+        header_->status_size != sizeof(shm_axis_status_t) ||
+        header_->command_size != sizeof(shm_command_t) ||
+        header_->size != layout(header_->number_of_controllers).size ||
+        header_->size > length_) {
+        close();
+        throw std::runtime_error("Invalid shared memory.");
+    }
+
+    pending_ = reinterpret_cast<std::atomic<uint64_t>*>(base + header_->pending_offset);
+    status_ = reinterpret_cast<const shm_status_t*>(base + header_->status_offset);
+    axes_ = reinterpret_cast<const shm_axis_status_t*>(base + header_->status_offset + sizeof(shm_status_t));
+    commands_ = reinterpret_cast<shm_command_t*>(base + header_->command_offset);
+}
+
+void motor_manager::SharedMemoryClient::close()
+{
+    if (header_) munmap(const_cast<shm_header_t*>(header_), length_);
+    header_ = nullptr;
+    length_ = 0;
+    pending_ = nullptr;
+    status_ = nullptr;
+    axes_ = nullptr;
+    commands_ = nullptr;
+}
+
+bool motor_manager::SharedMemoryClient::write(uint16_t index, const motor_interface::motor_frame_t& frame)
+{
+    if (index >= header_->number_of_controllers) return false;
+
+    shm_command_t& slot = commands_[index];
+    const uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.frame = frame;
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+
+    pending_[index / AXES_PER_WORD].fetch_or(uint64_t{1} << (index % AXES_PER_WORD), std::memory_order_release);
+    return true;
+}
+
+uint64_t motor_manager::SharedMemoryClient::read(motor_interface::motor_frame_t* status, bool* valid, int8_t* modes) const
+{
+    for (;;) {
+        const uint64_t sequence = status_->sequence.load(std::memory_order_acquire);
+        if (sequence & 1u) continue;
+
+        const uint64_t cycle = status_->cycle;
+        for (uint16_t i = 0; i < header_->number_of_controllers; ++i) {
+            status[i] = axes_[i].frame;
+            if (valid) valid[i] = axes_[i].valid != 0;
+            if (modes) modes[i] = axes_[i].mode;
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (status_->sequence.load(std::memory_order_relaxed) == sequence) return cycle;
+    }
+}
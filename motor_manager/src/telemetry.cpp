@@ -0,0 +1,282 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "motor_manager/telemetry.hpp"
+
+namespace {
+
+/** Entries the writer thread takes from the ring per `pop()`. */
+constexpr std::size_t DRAIN_BATCH = 256;
+
+constexpr char byte_order()
+{
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ ? '<' : '>';
+}
+
+std::string npy_field(const char* name, const char* type)
+{
+    return std::string("('") + name + "', '" + byte_order() + type + "'), ";
+}
+
+} // namespace
+
+motor_manager::TelemetryRecorder::TelemetryRecorder()
+: ring_(std::make_unique<SpscRing<entry_t, TELEMETRY_RING_SIZE>>())
+{
+}
+
+motor_manager::TelemetryRecorder::~TelemetryRecorder()
+{
+    stop();
+}
+
+void motor_manager::TelemetryRecorder::start(const std::string& path, uint32_t period, uint16_t number_of_axes)
+{
+    if (writer_.joinable()) throw std::runtime_error("Telemetry is already recording.");
+
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ == -1) throw std::runtime_error("Failed to create telemetry file.");
+
+    header_ = telemetry_header_t{
+        TELEMETRY_MAGIC, TELEMETRY_VERSION, period, sizeof(telemetry_sample_t), number_of_axes, 0, 0};
+    file_size_ = 0;
+    written_.store(0, std::memory_order_relaxed);
+    error_.store(0, std::memory_order_relaxed);
+    dropped_base_.store(dropped_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    if (!map(0)) {
+        ::close(fd_);
+        fd_ = -1;
+        throw std::runtime_error("Failed to map telemetry file.");
+    }
+    writeHeader();
+
+    last_session_ = last_session_ == UINT32_MAX ? 1 : last_session_ + 1;
+    stop_.store(false, std::memory_order_relaxed);
+    writer_ = std::thread(&TelemetryRecorder::runWriter, this);
+    session_.store(last_session_, std::memory_order_release);
+}
+
+void motor_manager::TelemetryRecorder::stop()
+{
+    if (!writer_.joinable()) return;
+
+    session_.store(0, std::memory_order_release);
+    stop_.store(true, std::memory_order_release);
+    writer_.join();
+
+    unmap();
+    writeHeader();
+    const uint64_t written = written_.load(std::memory_order_relaxed);
+    if (ftruncate(fd_, static_cast<off_t>(sizeof(telemetry_header_t) + written * sizeof(telemetry_sample_t))) == -1) {
+        int expected{0};
+        error_.compare_exchange_strong(expected, errno);
+    }
+    ::close(fd_);
+    fd_ = -1;
+}
+
+motor_manager::telemetry_statistics_t motor_manager::TelemetryRecorder::statistics() const
+{
+    telemetry_statistics_t statistics;
+    statistics.recording = session() != 0;
+    statistics.written = written_.load(std::memory_order_relaxed);
+    statistics.dropped = dropped_.load(std::memory_order_relaxed) - dropped_base_.load(std::memory_order_relaxed);
+    statistics.error = error_.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void motor_manager::TelemetryRecorder::runWriter()
+{
+    while (!stop_.load(std::memory_order_acquire)) {
+        if (drain() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(TELEMETRY_DRAIN_PERIOD));
+    }
+    while (drain() != 0) {}
+}
+
+std::size_t motor_manager::TelemetryRecorder::drain()
+{
+    entry_t batch[DRAIN_BATCH];
+    const std::size_t n = ring_->pop(batch, DRAIN_BATCH);
+    if (n == 0) return 0;
+
+    for (std::size_t k = 0; k < n; ++k) {
+        if (batch[k].session != last_session_) continue;  // straggler of a stopped session
+        if (error_.load(std::memory_order_relaxed) != 0 || !append(batch[k].sample)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    writeHeader();
+    return n;
+}
+
+bool motor_manager::TelemetryRecorder::append(const telemetry_sample_t& sample)
+{
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&sample);
+    const std::size_t offset =
+        sizeof(telemetry_header_t) + written_.load(std::memory_order_relaxed) * sizeof(telemetry_sample_t);
+
+    // A sample may straddle two windows.
+    std::size_t done{0};
+    while (done < sizeof(sample)) {
+        const std::size_t position = offset + done;
+        const std::size_t segment = position / TELEMETRY_SEGMENT_SIZE;
+        if ((!window_ || segment != segment_) && !map(segment)) return false;
+
+        const std::size_t in_segment = position % TELEMETRY_SEGMENT_SIZE;
+        const std::size_t length = std::min(sizeof(sample) - done, TELEMETRY_SEGMENT_SIZE - in_segment);
+        std::memcpy(window_ + in_segment, bytes + done, length);
+        done += length;
+    }
+    written_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool motor_manager::TelemetryRecorder::map(std::size_t segment)
+{
+    unmap();
+
+    const std::size_t end = (segment + 1) * TELEMETRY_SEGMENT_SIZE;
+    if (file_size_ < end) {
+        if (ftruncate(fd_, static_cast<off_t>(end)) == -1) {
+            int expected{0};
+            error_.compare_exchange_strong(expected, errno);
+            return false;
+        }
+        file_size_ = end;
+    }
+
+    void* data = mmap(nullptr, TELEMETRY_SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd_,
+        static_cast<off_t>(segment * TELEMETRY_SEGMENT_SIZE));
+    if (data == MAP_FAILED) {
+        int expected{0};
+        error_.compare_exchange_strong(expected, errno);
+        return false;
+    }
+    window_ = static_cast<uint8_t*>(data);
+    segment_ = segment;
+    return true;
+}
+
+void motor_manager::TelemetryRecorder::unmap()
+{
+    if (!window_) return;
+    munmap(window_, TELEMETRY_SEGMENT_SIZE);
+    window_ = nullptr;
+}
+
+void motor_manager::TelemetryRecorder::writeHeader()
+{
+    header_.number_of_samples = written_.load(std::memory_order_relaxed);
+    header_.dropped = dropped_.load(std::memory_order_relaxed) - dropped_base_.load(std::memory_order_relaxed);
+    if (pwrite(fd_, &header_, sizeof(header_), 0) != static_cast<ssize_t>(sizeof(header_))) {
+        int expected{0};
+        error_.compare_exchange_strong(expected, errno ? errno : EIO);
+    }
+}
+
+void motor_manager::TelemetryLog::open(const std::string& path)
+{
+    close();
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) throw std::runtime_error("Failed to open telemetry file.");
+
+    struct stat info{};
+    if (fstat(fd, &info) == -1 || static_cast<std::size_t>(info.st_size) < sizeof(telemetry_header_t)) {
+        ::close(fd);
+        throw std::runtime_error("Invalid telemetry file.");
+    }
+
+    length_ = static_cast<std::size_t>(info.st_size);
+    data_ = mmap(nullptr, length_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        throw std::runtime_error("Failed to map telemetry file.");
+    }
+
+    header_ = static_cast<const telemetry_header_t*>(data_);
+    if (header_->magic != TELEMETRY_MAGIC ||
+        header_->version != TELEMETRY_VERSION ||
+        header_->sample_size != sizeof(telemetry_sample_t)) {
+        close();
+        throw std::runtime_error("Invalid telemetry file.");
+    }
+
+    samples_ = reinterpret_cast<const telemetry_sample_t*>(static_cast<const uint8_t*>(data_) + sizeof(telemetry_header_t));
+    const std::size_t capacity = (length_ - sizeof(telemetry_header_t)) / sizeof(telemetry_sample_t);
+    size_ = std::min(static_cast<std::size_t>(header_->number_of_samples), capacity);
+}
+
+void motor_manager::TelemetryLog::close()
+{
+    if (data_) munmap(data_, length_);
+    data_ = nullptr;
+    length_ = 0;
+    header_ = nullptr;
+    samples_ = nullptr;
+    size_ = 0;
+}
+
+void motor_manager::writeCsv(const TelemetryLog& log, std::ostream& out)
+{
+    out << "cycle,time,axis,controlword,statusword,errorcode,valid,mode,mode_display,targets,"
+           "command_position,command_velocity,command_torque,position,velocity,torque\n";
+
+    char line[512];
+    for (std::size_t k = 0; k < log.size(); ++k) {
+        const telemetry_sample_t& s = log.samples()[k];
+        const int n = std::snprintf(line, sizeof(line),
+            "%llu,%llu,%u,%u,%u,%u,%u,%d,%d,%u,%.17g,%.17g,%.17g,%.17g,%.17g,%.17g\n",
+            static_cast<unsigned long long>(s.cycle), static_cast<unsigned long long>(s.time),
+            s.axis, s.controlword, s.statusword, s.errorcode, s.valid, s.mode, s.mode_display, s.targets,
+            s.command_position, s.command_velocity, s.command_torque, s.position, s.velocity, s.torque);
+        out.write(line, n);
+    }
+}
+
+void motor_manager::writeNpy(const TelemetryLog& log, std::ostream& out)
+{
+    // Field order and sizes are those of telemetry_sample_t, which has no implicit padding.
+    std::string dict = "{'descr': [";
+    dict += npy_field("cycle", "u8");
+    dict += npy_field("time", "u8");
+    dict += npy_field("command_position", "f8");
+    dict += npy_field("command_velocity", "f8");
+    dict += npy_field("command_torque", "f8");
+    dict += npy_field("position", "f8");
+    dict += npy_field("velocity", "f8");
+    dict += npy_field("torque", "f8");
+    dict += npy_field("controlword", "u2");
+    dict += npy_field("statusword", "u2");
+    dict += npy_field("errorcode", "u2");
+    dict += npy_field("axis", "u2");
+    dict += "('valid', '|u1'), ('mode', '|i1'), ('mode_display', '|i1'), ('targets', '|u1'), ('reserved', '|V4')], "
+            "'fortran_order': False, 'shape': (";
+    dict += std::to_string(log.size()) + ",), }";
+
+    // Magic (6) + version (2) + length (2) + dictionary + '\n', padded to 64 bytes.
+    const std::size_t unpadded = 10 + dict.size() + 1;
+    dict.append((64 - unpadded % 64) % 64, ' ');
+    dict += '\n';
+
+    const uint16_t length = static_cast<uint16_t>(dict.size());
+    const char preamble[10] = {
+        '\x93', 'N', 'U', 'M', 'P', 'Y', 1, 0,
+        static_cast<char>(length & 0xFF), static_cast<char>(length >> 8)};
+    out.write(preamble, sizeof(preamble));
+    out.write(dict.data(), static_cast<std::streamsize>(dict.size()));
+    out.write(reinterpret_cast<const char*>(log.samples()),
+        static_cast<std::streamsize>(log.size() * sizeof(telemetry_sample_t)));
+}
@@ -0,0 +1,36 @@
+#include <cstdio>
+#include <exception>
+#include <memory>
+#include <string>
+
+#include "motor_manager/config_image.hpp"
+
+/** `motor_manager_config <config.yaml> [output]`: compiles the configuration ahead of time (default output: `<config.yaml>.cache`). */
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <config.yaml> [output]\n", argv[0]);
+        return 2;
+    }
+
+    const std::string config_file = argv[1];
+    const std::string output = argc == 3 ? argv[2] : config_file + motor_manager::CONFIG_IMAGE_SUFFIX;
+
+    auto image = std::make_unique<motor_manager::config_image_t>();
+    try {
+        motor_manager::compileConfiguration(config_file, *image);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\n", config_file.c_str(), e.what());
+        return 1;
+    }
+
+    if (!motor_manager::saveConfigImage(*image, output)) {
+        std::fprintf(stderr, "failed to write %s\n", output.c_str());
+        return 1;
+    }
+
+    std::printf("%s: %u masters, %u slaves, %u drivers, %zu bytes, source hash %016llx\n",
+        output.c_str(), image->number_of_masters, image->number_of_slaves, image->number_of_drivers,
+        sizeof(motor_manager::config_image_t), static_cast<unsigned long long>(image->header.source_hash));
+    return 0;
+}
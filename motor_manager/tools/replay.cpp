@@ -0,0 +1,188 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <time.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "motor_manager/cycle_statistics.hpp"
+#include "motor_manager/telemetry.hpp"
+#include "simulation/simulation_controller.hpp"
+
+namespace {
+
+constexpr uint64_t FNV64_OFFSET = 0xCBF29CE484222325ULL;
+constexpr uint64_t FNV64_PRIME = 0x00000100000001B3ULL;
+
+uint64_t fnv64(uint64_t hash, const uint8_t* data, std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= FNV64_PRIME;
+    }
+    return hash;
+}
+
+uint64_t thread_time()
+{
+    timespec time{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return static_cast<uint64_t>(time.tv_sec) * motor_manager::NSEC_PER_SEC + static_cast<uint64_t>(time.tv_nsec);
+}
+
+int32_t counts(double value, double scale)
+{
+    return scale != 0.0 ? static_cast<int32_t>(std::llround(value / scale)) : 0;
+}
+
+bool same_command(const motor_manager::telemetry_sample_t& a, const motor_manager::telemetry_sample_t& b)
+{
+    return a.controlword == b.controlword &&
+        a.command_position == b.command_position &&
+        a.command_velocity == b.command_velocity &&
+        a.command_torque == b.command_torque &&
+        a.targets == b.targets;
+}
+
+/** The recorded command as a client frame: every recorded target the axis maps, with its interface id. */
+void command(const motor_manager::telemetry_sample_t& sample, uint16_t mapped, motor_interface::motor_frame_t& frame)
+{
+    frame.controlword = sample.controlword;
+    frame.position = sample.command_position;
+    frame.velocity = sample.command_velocity;
+    frame.torque = sample.command_torque;
+    frame.number_of_target_interfaces = 0;
+    for (uint8_t id = motor_interface::ID_CONTROLWORD; id <= motor_interface::ID_TARGET_TORQUE; ++id) {
+        if ((sample.targets & mapped & (1u << id)) == 0) continue;
+        frame.target_interface_id[frame.number_of_target_interfaces++] = id;
+    }
+}
+
+/** Output bytes of one simulated slave: controlword, targets and mode of operation as they sit in the process image. */
+uint64_t digest(uint64_t hash, simulation::SimulationController& controller)
+{
+    simulation::SimulationMaster& master = *controller.master();
+    const simulation::virtual_slave_t& slave = master.slave(controller.slave_index());
+    for (const simulation::pdo_slot_t* slot : {
+             &slave.controlword, &slave.target_position, &slave.target_velocity, &slave.target_torque, &slave.mode_of_operation}) {
+        if (slot->offset == simulation::UNMAPPED) continue;
+        hash = fnv64(hash, master.process_data() + slot->offset, slot->size);
+    }
+    return hash;
+}
+
+} // namespace
+
+/**
+ * `motor_manager_replay <config.yaml> <log> [--expect <digest>]`: replays a telemetry log through `MotorManager::step()`
+ * on simulated masters. Each cycle the slaves report the recorded status and the recorded commands are written;
+ * the command output is hashed and the CPU time of every step measured. Exits 1 when `--expect` does not match.
+ */
+int main(int argc, char** argv)
+{
+    if (argc != 3 && !(argc == 5 && std::strcmp(argv[3], "--expect") == 0)) {
+        std::fprintf(stderr, "usage: %s <config.yaml> <log> [--expect <digest>]\n", argv[0]);
+        return 2;
+    }
+
+    try {
+        motor_manager::TelemetryLog log;
+        log.open(argv[2]);
+
+        motor_manager::MotorManager manager(argv[1]);
+        const uint16_t n = manager.number_of_controllers();
+        if (log.header().number_of_axes != n) {
+            std::fprintf(stderr, "log has %u axes, configuration %u\n", log.header().number_of_axes, n);
+            return 1;
+        }
+
+        std::vector<simulation::SimulationController*> controllers(n);
+        std::vector<motor_interface::axis_scale_t> scales(n);
+        for (uint16_t i = 0; i < n; ++i) {
+            controllers[i] = dynamic_cast<simulation::SimulationController*>(&manager.controller(i));
+            if (!controllers[i]) {
+                std::fprintf(stderr, "axis %u is not on a simulation master\n", i);
+                return 1;
+            }
+            scales[i] = controllers[i]->driver()->scale();
+        }
+
+        manager.start();
+
+        std::vector<motor_interface::motor_frame_t> frames(n);
+        std::vector<motor_manager::telemetry_sample_t> previous(n);
+        motor_manager::LatencyHistogram cpu;
+        uint64_t hash = FNV64_OFFSET;
+        uint64_t cycles{0};
+
+        const auto wall_start = std::chrono::steady_clock::now();
+        std::size_t k{0};
+        while (k < log.size()) {
+            const motor_manager::telemetry_sample_t* samples = log.samples();
+            const uint64_t cycle = samples[k].cycle;
+            const uint64_t time = samples[k].time;
+
+            // Samples of one cycle are contiguous; an axis dropped from the log keeps its previous values.
+            bool changed{false};
+            for (; k < log.size() && samples[k].cycle == cycle; ++k) {
+                const motor_manager::telemetry_sample_t& s = samples[k];
+                if (s.axis >= n) continue;
+
+                const motor_interface::axis_scale_t& scale = scales[s.axis];
+                controllers[s.axis]->master()->replay(controllers[s.axis]->slave_index(), simulation::replay_status_t{
+                    s.statusword, s.errorcode,
+                    counts(s.position, scale.position), counts(s.velocity, scale.velocity), counts(s.torque, scale.torque),
+                    s.mode_display});
+
+                // set_mode() rejects axes without 0x6060 and non-cyclic modes, like the recording did.
+                if (s.mode != previous[s.axis].mode) {
+                    manager.set_mode(s.axis, static_cast<motor_interface::OperationMode>(s.mode));
+                }
+                if (!same_command(s, previous[s.axis])) changed = true;
+                previous[s.axis] = s;
+            }
+
+            // Like a client write(), only when the recorded command changed.
+            if (changed) {
+                for (uint16_t i = 0; i < n; ++i) command(previous[i], controllers[i]->mapped(), frames[i]);
+                manager.write(frames.data(), n);
+            }
+
+            const uint64_t begin = thread_time();
+            const bool running = manager.step(time);
+            cpu.record(thread_time() - begin);
+            cycles++;
+
+            for (uint16_t i = 0; i < n; ++i) hash = digest(hash, *controllers[i]);
+            if (!running) break;
+        }
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count();
+
+        manager.stop();
+
+        std::printf("cycles %llu axes %u wall %.3f s (%.0f cycles/s)\n",
+            static_cast<unsigned long long>(cycles), n, wall, wall > 0.0 ? cycles / wall : 0.0);
+        std::printf("step cpu ns: mean %llu p50 %llu p99 %llu max %llu\n",
+            static_cast<unsigned long long>(cpu.mean()), static_cast<unsigned long long>(cpu.percentile(50)),
+            static_cast<unsigned long long>(cpu.percentile(99)), static_cast<unsigned long long>(cpu.max()));
+        std::printf("digest %016llx\n", static_cast<unsigned long long>(hash));
+
+        if (argc == 5) {
+            const uint64_t expected = std::strtoull(argv[4], nullptr, 16);
+            if (expected != hash) {
+                std::fprintf(stderr, "digest mismatch: expected %016llx\n", static_cast<unsigned long long>(expected));
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s\n", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <string>
+
+#include "motor_manager/telemetry.hpp"
+
+namespace {
+
+bool ends_with(const std::string& text, const std::string& suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+/** `motor_manager_telemetry <log> <output.csv|output.npy>`: converts a telemetry log; without an output, prints its summary. */
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::fprintf(stderr, "usage: %s <log> [output.csv|output.npy]\n", argv[0]);
+        return 2;
+    }
+
+    motor_manager::TelemetryLog log;
+    try {
+        log.open(argv[1]);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "%s: %s\n", argv[1], e.what());
+        return 1;
+    }
+
+    const motor_manager::telemetry_header_t& header = log.header();
+    std::printf("%s: %zu samples, %u axes, period %u ns, %llu dropped\n",
+        argv[1], log.size(), header.number_of_axes, header.period, static_cast<unsigned long long>(header.dropped));
+    if (argc == 2) return 0;
+
+    const std::string output = argv[2];
+    std::ofstream out(output, std::ios::binary);
+    if (!out) {
+        std::fprintf(stderr, "failed to create %s\n", output.c_str());
+        return 1;
+    }
+
+    if (ends_with(output, ".npy")) {
+        motor_manager::writeNpy(log, out);
+    } else if (ends_with(output, ".csv")) {
+        motor_manager::writeCsv(log, out);
+    } else {
+        std::fprintf(stderr, "unknown output format: %s (use .csv or .npy)\n", output.c_str());
+        return 2;
+    }
+    return out ? 0 : 1;
+}
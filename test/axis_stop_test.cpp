@@ -0,0 +1,114 @@
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+const simulation::virtual_slave_t& slave(motor_manager::MotorManager& manager, uint16_t index)
+{
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(index));
+    return controller.master()->slave(controller.slave_index());
+}
+
+motor_interface::motor_frame_t position(double value)
+{
+    motor_interface::motor_frame_t frame{};
+    frame.number_of_target_interfaces = 1;
+    frame.target_interface_id[0] = motor_interface::ID_TARGET_POSITION;
+    frame.position = value;
+    return frame;
+}
+
+TEST(AxisStop, QuickStopHaltAndResume)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("axis_stop"));
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    ASSERT_EQ(manager.controller(0).controlword(), 0x000F);
+
+    motor_interface::motor_frame_t frames[2]{position(1.0), position(1.0)};
+    manager.write(frames, 2);
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    // The quick stop command is held while the axis stays stopped; the other axis keeps moving.
+    ASSERT_TRUE(manager.quick_stop(0));
+    for (int k = 0; k < 3; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(manager.controller(0).controlword(), 0x0002);
+    EXPECT_EQ(slave(manager, 0).state, simulation::SlaveState::QuickStopActive);
+    motor_interface::motor_frame_t status[2];
+    manager.read(status);
+    EXPECT_EQ(status[0].statusword & 0x006F, 0x0007);
+    const double stopped = slave(manager, 0).position;
+    const double moving = slave(manager, 1).position;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(slave(manager, 0).position, stopped);
+    EXPECT_GT(slave(manager, 1).position, moving);
+    EXPECT_EQ(manager.controller(1).controlword(), 0x000F);
+    motor_manager::bus_health_t health = manager.health();
+    EXPECT_EQ(health.stopped_axes, 1);
+    EXPECT_EQ(health.axis_stops, 1u);
+    EXPECT_EQ(health.faulted_axes, 0);
+
+    // Resume walks back through switch-on disabled from the measured position: no jump toward the old target.
+    ASSERT_TRUE(manager.resume(0));
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(manager.controller(0).controlword(), 0x000F);
+    EXPECT_EQ(slave(manager, 0).state, simulation::SlaveState::OperationEnabled);
+    EXPECT_NEAR(slave(manager, 0).position, stopped, 1.0);
+    health = manager.health();
+    EXPECT_EQ(health.stopped_axes, 0);
+    EXPECT_EQ(health.axis_resumes, 1u);
+
+    // Halt keeps the drive in operation enabled with the halt bit set, standing still.
+    ASSERT_TRUE(manager.halt(1));
+    for (int k = 0; k < 3; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(manager.controller(1).controlword(), 0x010F);
+    EXPECT_EQ(slave(manager, 1).state, simulation::SlaveState::OperationEnabled);
+    const double halted = slave(manager, 1).position;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(slave(manager, 1).position, halted);
+    health = manager.health();
+    EXPECT_EQ(health.stopped_axes, 1);
+    EXPECT_EQ(health.axis_stops, 2u);
+
+    // A command written while halted goes out once the axis is resumed.
+    frames[1] = position(-1.0);
+    manager.write(frames, 2);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(slave(manager, 1).position, halted);
+    ASSERT_TRUE(manager.resume(1));
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(manager.controller(1).controlword(), 0x000F);
+    EXPECT_LT(slave(manager, 1).position, halted);
+    health = manager.health();
+    EXPECT_EQ(health.stopped_axes, 0);
+    EXPECT_EQ(health.axis_resumes, 2u);
+}
+
+TEST(AxisStop, ResumeOnRunningAxisIsNoOp)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("axis_stop_noop"));
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    ASSERT_TRUE(manager.resume(0));
+    EXPECT_FALSE(manager.quick_stop(2));
+    EXPECT_FALSE(manager.halt(2));
+    EXPECT_FALSE(manager.resume(2));
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(manager.controller(0).controlword(), 0x000F);
+    const motor_manager::bus_health_t health = manager.health();
+    EXPECT_EQ(health.axis_stops, 0u);
+    EXPECT_EQ(health.axis_resumes, 0u);
+}
+
+} // namespace
@@ -0,0 +1,212 @@
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "motor_interface/cia402.hpp"
+#include "minas/minas_driver.hpp"
+#include "zeroerr/zeroerr_driver.hpp"
+
+namespace {
+
+using motor_interface::Cia402Goal;
+using motor_interface::DriverState;
+using motor_interface::cia402_axis_t;
+using motor_interface::cia402_descriptor_t;
+
+/** Every descriptor the tree ships; each must walk the same CiA402 graph with its own controlwords. */
+const cia402_descriptor_t* const DESCRIPTORS[] = {
+    &motor_interface::CIA402_STANDARD, &minas::MINAS_CIA402, &zeroerr::ZEROERR_CIA402};
+
+/**
+ * Drive reporting synthetic statuswords: the CiA402 device control graph on controlword commands (bit 5 and the
+ * halt bit do not select a command, as with both vendors), a fault reset on the rising edge of bit 7.
+ */
+struct synthetic_drive_t {
+    const cia402_descriptor_t& descriptor;
+
+    DriverState state{DriverState::SwitchOnDisabled};
+
+    uint16_t last_controlword{0};
+
+    /** The fault stays latched through resets. */
+    bool stuck{false};
+
+    uint16_t statusword() const { return descriptor.patterns[static_cast<uint8_t>(state)].value; }
+
+    void apply(uint16_t cw)
+    {
+        using S = DriverState;
+        const bool fault_reset = (cw & 0x0080) && !(last_controlword & 0x0080);
+        last_controlword = cw;
+        if (state == S::Fault) {
+            if (fault_reset && !stuck) state = S::SwitchOnDisabled;
+            return;
+        }
+        if (cw & 0x0080) return;
+
+        const bool disable_voltage = (cw & 0x0002) == 0;
+        const bool quick_stop = (cw & 0x0006) == 0x0002;
+        const bool shutdown = (cw & 0x0007) == 0x0006;
+        const bool switch_on = (cw & 0x000F) == 0x0007;
+        const bool enable_operation = (cw & 0x000F) == 0x000F;
+        switch (state) {
+        case S::SwitchOnDisabled: {
+            if (shutdown) state = S::ReadyToSwitchOn;
+            break;
+        } case S::ReadyToSwitchOn: {
+            if (disable_voltage || quick_stop) state = S::SwitchOnDisabled;
+            else if (switch_on || enable_operation) state = S::SwitchedOn;
+            break;
+        } case S::SwitchedOn: {
+            if (disable_voltage || quick_stop) state = S::SwitchOnDisabled;
+            else if (shutdown) state = S::ReadyToSwitchOn;
+            else if (enable_operation) state = S::OperationEnabled;
+            break;
+        } case S::OperationEnabled: {
+            if (disable_voltage) state = S::SwitchOnDisabled;
+            else if (quick_stop) state = S::QuickStopActive;
+            else if (shutdown) state = S::ReadyToSwitchOn;
+            else if (switch_on) state = S::SwitchedOn;
+            break;
+        } case S::QuickStopActive: {
+            if (disable_voltage) state = S::SwitchOnDisabled;
+            else if (enable_operation) state = S::OperationEnabled;
+            break;
+        } default: {
+            break;
+        }
+        }
+    }
+};
+
+/** Steps `goal` against `drive` until reached or `limit` cycles; returns the controlwords written on the way. */
+std::vector<uint16_t> walk(synthetic_drive_t& drive, cia402_axis_t& axis, Cia402Goal goal, int limit = 10)
+{
+    std::vector<uint16_t> written;
+    for (int k = 0; k < limit; ++k) {
+        uint16_t cw{0};
+        if (motor_interface::step(drive.descriptor, goal, drive.statusword(), axis, cw)) return written;
+        written.push_back(cw);
+        drive.apply(cw);
+    }
+    ADD_FAILURE() << "goal not reached in " << limit << " cycles";
+    return written;
+}
+
+class Cia402Walk : public ::testing::TestWithParam<const cia402_descriptor_t*> {};
+
+TEST_P(Cia402Walk, DecodesEveryStatePattern)
+{
+    const cia402_descriptor_t& d = *GetParam();
+    for (uint8_t s = 0; s < motor_interface::NUMBER_OF_DRIVER_STATES; ++s) {
+        EXPECT_EQ(motor_interface::decode(d, d.patterns[s].value), static_cast<DriverState>(s));
+    }
+}
+
+TEST_P(Cia402Walk, EnableQuickStopHaltAndFaultReset)
+{
+    const cia402_descriptor_t& d = *GetParam();
+    const uint16_t* enable = d.controlwords[static_cast<uint8_t>(Cia402Goal::Enable)];
+    const uint16_t* halt = d.controlwords[static_cast<uint8_t>(Cia402Goal::Halt)];
+    synthetic_drive_t drive{d};
+    cia402_axis_t axis;
+
+    // Enable: shutdown, switch on, enable operation, one per reported state.
+    EXPECT_EQ(walk(drive, axis, Cia402Goal::Enable), (std::vector<uint16_t>{
+        enable[static_cast<uint8_t>(DriverState::SwitchOnDisabled)],
+        enable[static_cast<uint8_t>(DriverState::ReadyToSwitchOn)],
+        enable[static_cast<uint8_t>(DriverState::SwitchedOn)]}));
+    EXPECT_EQ(drive.state, DriverState::OperationEnabled);
+
+    // QuickStop: one quick stop command, reached in quick stop active.
+    const std::vector<uint16_t> quick_stop = walk(drive, axis, Cia402Goal::QuickStop);
+    ASSERT_EQ(quick_stop.size(), 1u);
+    EXPECT_EQ(quick_stop[0] & 0x0006, 0x0002);
+    EXPECT_EQ(drive.state, DriverState::QuickStopActive);
+
+    // Halt out of quick stop: back through switch-on disabled, then enable operation with the halt bit.
+    const std::vector<uint16_t> halting = walk(drive, axis, Cia402Goal::Halt);
+    ASSERT_FALSE(halting.empty());
+    EXPECT_EQ(halting.back(), halt[static_cast<uint8_t>(DriverState::SwitchedOn)]);
+    EXPECT_TRUE(halting.back() & 0x0100);
+    EXPECT_EQ(drive.state, DriverState::OperationEnabled);
+
+    // Once halted, the goal holds with the halt bit still in the controlword.
+    uint16_t cw{0};
+    EXPECT_TRUE(motor_interface::step(d, Cia402Goal::Halt, drive.statusword(), axis, cw));
+    EXPECT_EQ(cw, halt[static_cast<uint8_t>(DriverState::OperationEnabled)]);
+    EXPECT_TRUE(cw & 0x0100);
+    EXPECT_TRUE(motor_interface::step(d, Cia402Goal::Enable, drive.statusword(), axis, cw));
+    EXPECT_FALSE(cw & 0x0100);
+
+    // Fault reset: the rising edge of bit 7, then the enable walk again.
+    drive.state = DriverState::Fault;
+    const std::vector<uint16_t> reset = walk(drive, axis, Cia402Goal::Enable);
+    ASSERT_EQ(reset.size(), 4u);
+    EXPECT_EQ(reset[0], enable[static_cast<uint8_t>(DriverState::Fault)]);
+    EXPECT_TRUE(reset[0] & 0x0080);
+    EXPECT_EQ(drive.state, DriverState::OperationEnabled);
+    EXPECT_EQ(axis.timeouts, 0u);
+}
+
+TEST_P(Cia402Walk, RetriesStuckFaultReset)
+{
+    const cia402_descriptor_t& d = *GetParam();
+    const uint16_t timeout = d.timeouts[static_cast<uint8_t>(DriverState::Fault)];
+    ASSERT_GT(timeout, 0);
+    synthetic_drive_t drive{d, DriverState::Fault};
+    drive.stuck = true;
+    cia402_axis_t axis;
+
+    // The reset bit stays set while the drive does not leave the fault, so no new edge goes out until the retry.
+    std::vector<uint16_t> written;
+    for (int k = 0; k <= timeout; ++k) {
+        uint16_t cw{0};
+        ASSERT_FALSE(motor_interface::step(d, Cia402Goal::Enable, drive.statusword(), axis, cw));
+        written.push_back(cw);
+        drive.apply(cw);
+    }
+    for (int k = 0; k < timeout; ++k) EXPECT_TRUE(written[k] & 0x0080) << "cycle " << k;
+    EXPECT_EQ(written[timeout], d.retry);
+    EXPECT_FALSE(d.retry & 0x0080);
+    EXPECT_EQ(axis.timeouts, 1u);
+
+    // With a fresh edge the drive recovers and the walk completes.
+    drive.stuck = false;
+    walk(drive, axis, Cia402Goal::Enable);
+    EXPECT_EQ(drive.state, DriverState::OperationEnabled);
+    EXPECT_EQ(axis.timeouts, 1u);
+}
+
+TEST_P(Cia402Walk, RetriesStuckTransition)
+{
+    const cia402_descriptor_t& d = *GetParam();
+    const uint16_t timeout = d.timeouts[static_cast<uint8_t>(DriverState::ReadyToSwitchOn)];
+    cia402_axis_t axis;
+
+    // A drive that never leaves ready to switch on gets `retry` once per timeout, then the walk restarts.
+    const uint16_t statusword = d.patterns[static_cast<uint8_t>(DriverState::ReadyToSwitchOn)].value;
+    uint16_t cw{0};
+    uint32_t retries{0};
+    for (uint32_t k = 0; k < 2u * timeout + 2; ++k) {
+        EXPECT_FALSE(motor_interface::step(d, Cia402Goal::Enable, statusword, axis, cw));
+        if (cw == d.retry) retries++;
+    }
+    EXPECT_EQ(retries, 2u);
+    EXPECT_EQ(axis.timeouts, 2u);
+}
+
+TEST_P(Cia402Walk, QuickStopCountsDisabledDrivesAsStopped)
+{
+    const cia402_descriptor_t& d = *GetParam();
+    for (const DriverState state : {DriverState::SwitchOnDisabled, DriverState::Fault, DriverState::NotReadyToSwitchOn}) {
+        cia402_axis_t axis;
+        uint16_t cw{0};
+        EXPECT_TRUE(motor_interface::step(d, Cia402Goal::QuickStop, d.patterns[static_cast<uint8_t>(state)].value, axis, cw));
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Descriptors, Cia402Walk, ::testing::ValuesIn(DESCRIPTORS));
+
+} // namespace
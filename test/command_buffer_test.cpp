@@ -0,0 +1,71 @@
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+constexpr uint16_t AXES = 4;
+
+motor_manager::axis_command_t position(uint16_t index, double value)
+{
+    motor_manager::axis_command_t command{index, {}};
+    command.frame.number_of_target_interfaces = 1;
+    command.frame.target_interface_id[0] = motor_interface::ID_TARGET_POSITION;
+    command.frame.position = value;
+    return command;
+}
+
+int64_t target(motor_manager::MotorManager& manager, uint16_t index)
+{
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(index));
+    return controller.master()->slave(controller.slave_index()).target_position_value;
+}
+
+TEST(CommandBuffer, SparseWritesOnOlderSlotsKeepEveryAxis)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("command_buffer", "", "", AXES));
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    // Without a cycle in between, each write() publishes into the slot the previous one left behind: every slot
+    // must be patched with the axes written into the others since it was last filled.
+    const double values[AXES] = {0.1, 0.2, 0.3, 0.4};
+    for (uint16_t i = 0; i < AXES; ++i) {
+        const motor_manager::axis_command_t command = position(i, values[i]);
+        manager.write(&command, 1);
+    }
+    for (int k = 0; k < 3; ++k) manager.step(time += PERIOD);
+    int64_t counts[AXES];
+    for (uint16_t i = 0; i < AXES; ++i) {
+        counts[i] = target(manager, i);
+        EXPECT_GT(counts[i], 0) << "axis " << i;
+        if (i > 0) {
+            EXPECT_GT(counts[i], counts[i - 1]) << "axis " << i;
+        }
+    }
+
+    // Rewritten axes, and slots that stayed back for several writes, with cycles interleaved.
+    const motor_manager::axis_command_t a = position(0, -0.1);
+    manager.write(&a, 1);
+    manager.step(time += PERIOD);
+    const motor_manager::axis_command_t b = position(2, -0.3);
+    manager.write(&b, 1);
+    const motor_manager::axis_command_t c = position(0, 0.1);
+    manager.write(&c, 1);
+    const motor_manager::axis_command_t d = position(3, -0.4);
+    manager.write(&d, 1);
+    for (int k = 0; k < 3; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(target(manager, 0), counts[0]);
+    EXPECT_EQ(target(manager, 1), counts[1]);
+    EXPECT_EQ(target(manager, 2), -counts[2]);
+    EXPECT_EQ(target(manager, 3), -counts[3]);
+}
+
+} // namespace
@@ -0,0 +1,75 @@
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/config_image.hpp"
+#include "motor_manager/motor_manager.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+/** Sets (or, with `nullptr`, unsets) an environment variable and restores its previous value on destruction. */
+class ScopedEnvironment {
+public:
+    ScopedEnvironment(const char* name, const char* value) : name_(name)
+    {
+        if (const char* previous = std::getenv(name)) previous_ = previous;
+        if (value) setenv(name, value, 1);
+        else unsetenv(name);
+    }
+
+    ~ScopedEnvironment()
+    {
+        if (previous_) setenv(name_, previous_->c_str(), 1);
+        else unsetenv(name_);
+    }
+
+private:
+    const char* name_;
+
+    std::optional<std::string> previous_;
+};
+
+TEST(ConfigCache, WritesImageToCacheDirectoryNotNextToYaml)
+{
+    const std::string config = test::writeConfiguration("cache");
+    const std::filesystem::path cache_dir = std::filesystem::path(config).parent_path() / "cache";
+    const ScopedEnvironment environment(motor_manager::CONFIG_CACHE_DIR_ENV, cache_dir.c_str());
+
+    const std::string image = motor_manager::configCachePath(config);
+    EXPECT_EQ(std::filesystem::path(image).parent_path(), cache_dir);
+
+    EXPECT_FALSE(motor_manager::MotorManager(config).loaded_from_cache());
+    EXPECT_TRUE(std::filesystem::exists(image));
+    EXPECT_FALSE(std::filesystem::exists(config + motor_manager::CONFIG_IMAGE_SUFFIX));
+
+    EXPECT_TRUE(motor_manager::MotorManager(config).loaded_from_cache());
+}
+
+TEST(ConfigCache, PrefersPrecompiledImageNextToYaml)
+{
+    const std::string config = test::writeConfiguration("precompiled");
+    const std::filesystem::path cache_dir = std::filesystem::path(config).parent_path() / "cache";
+    const ScopedEnvironment environment(motor_manager::CONFIG_CACHE_DIR_ENV, cache_dir.c_str());
+
+    auto image = std::make_unique<motor_manager::config_image_t>();
+    motor_manager::compileConfiguration(config, *image);
+    ASSERT_TRUE(motor_manager::saveConfigImage(*image, config + motor_manager::CONFIG_IMAGE_SUFFIX));
+
+    EXPECT_TRUE(motor_manager::MotorManager(config).loaded_from_cache());
+    EXPECT_FALSE(std::filesystem::exists(cache_dir));
+}
+
+TEST(ConfigCache, FallsBackToXdgCacheHome)
+{
+    const ScopedEnvironment cache_dir(motor_manager::CONFIG_CACHE_DIR_ENV, nullptr);
+    const ScopedEnvironment xdg("XDG_CACHE_HOME", "/var/cache/xdg");
+    EXPECT_EQ(std::filesystem::path(motor_manager::configCachePath("config.yaml")).parent_path(),
+        std::filesystem::path("/var/cache/xdg/motor_manager"));
+}
+
+} // namespace
@@ -0,0 +1,32 @@
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+TEST(ControllerIndex, StopsAtEightBitsInsteadOfWrapping)
+{
+    constexpr uint16_t AXES = 300;
+    const std::string config = test::writeConfiguration("controller_index", "", "", AXES);
+    motor_manager::MotorManager manager(config);
+
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 5; ++k) manager.step(time += 1000000);
+
+    std::vector<motor_interface::motor_frame_t> status(AXES);
+    manager.read(status.data());
+    EXPECT_EQ(status[0].controller_index, 0);
+    EXPECT_EQ(status[254].controller_index, 254);
+    EXPECT_EQ(status[255].controller_index, motor_interface::FRAME_INDEX_NONE);
+    EXPECT_EQ(status[256].controller_index, motor_interface::FRAME_INDEX_NONE);  // would wrap to 0
+    EXPECT_EQ(status[AXES - 1].controller_index, motor_interface::FRAME_INDEX_NONE);
+    manager.stop();
+}
+
+} // namespace
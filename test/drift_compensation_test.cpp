@@ -0,0 +1,88 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint32_t PERIOD = 1000000;
+
+/** Stands in for `run()`'s clock: each wakeup is one period plus the manager's correction on a virtual monotonic clock. */
+struct virtual_clock_t {
+    uint64_t wakeup{1000000000};
+
+    uint64_t application_time{1000000000};
+
+    void run(motor_manager::MotorManager& manager, simulation::SimulationMaster& master, uint32_t cycles)
+    {
+        for (uint32_t k = 0; k < cycles; ++k) {
+            wakeup += PERIOD + manager.correction();
+            application_time += PERIOD;
+            master.set_monotonic_time(wakeup);
+            manager.step(application_time, wakeup);
+        }
+    }
+};
+
+TEST(DriftCompensation, SettlesOnSimulatedReferenceClockDrift)
+{
+    const std::string config = test::writeConfiguration(
+        "drift",
+        "clock_sync: {master: 0}\n",
+        "    clock_drift: 50\n");
+    motor_manager::MotorManager manager(config);
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+
+    virtual_clock_t clock;
+    manager.start();
+    clock.run(manager, *controller.master(), 20000);
+    const motor_manager::cycle_statistics_t settled = manager.statistics();
+    EXPECT_NEAR(settled.clock_sync.drift_ppm, 50.0, 1.0);
+
+    // Once settled, the offset stays near zero; the largest one, from the pull-in, stays far below a period.
+    clock.run(manager, *controller.master(), 5 * motor_manager::STATISTICS_PUBLISH_CYCLES);
+    const motor_manager::cycle_statistics_t steady = manager.statistics();
+    EXPECT_NEAR(steady.clock_sync.drift_ppm, 50.0, 1.0);
+    EXPECT_LT(std::abs(steady.clock_sync.offset), 200);
+    EXPECT_LT(steady.clock_sync.max_offset, PERIOD / 100);
+    manager.stop();
+}
+
+TEST(DriftCompensation, SamplesWaypointsOnMonotonicWakeup)
+{
+    // A fast drifting reference clock, so application time and monotonic wakeups are far apart within seconds.
+    const std::string config = test::writeConfiguration(
+        "drift_trajectory",
+        "clock_sync: {master: 0}\n",
+        "    clock_drift: 5000\n");
+    motor_manager::MotorManager manager(config);
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+    const simulation::virtual_slave_t& slave = controller.master()->slave(controller.slave_index());
+
+    virtual_clock_t clock;
+    manager.start();
+    clock.run(manager, *controller.master(), 5000);
+    const uint64_t skew = clock.application_time > clock.wakeup ?
+        clock.application_time - clock.wakeup : clock.wakeup - clock.application_time;
+    ASSERT_GT(skew, 10u * PERIOD);
+
+    // A planner stamps waypoints on CLOCK_MONOTONIC. The segment starts at the next wakeup and lasts 20 periods;
+    // 11 cycles later the drive has the set-point of cycle 10 (one cycle of transport), 9 / 20 of the way.
+    const motor_manager::waypoint_t waypoint{clock.wakeup + 21 * PERIOD, 0.2, 0.0, 0.0, motor_manager::Interpolation::Linear};
+    ASSERT_EQ(manager.write(0, &waypoint, 1), 1);
+    clock.run(manager, *controller.master(), 11);
+    const double counts = 0.2 * 8388608 / (2 * M_PI);
+    EXPECT_NEAR(static_cast<double>(slave.target_position_value), counts * 9 / 20, counts * 0.01);
+
+    clock.run(manager, *controller.master(), 12);
+    EXPECT_NEAR(static_cast<double>(slave.target_position_value), counts, 1.0);
+    manager.stop();
+}
+
+} // namespace
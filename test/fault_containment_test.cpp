@@ -0,0 +1,71 @@
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+motor_interface::motor_frame_t position(double value)
+{
+    motor_interface::motor_frame_t frame{};
+    frame.number_of_target_interfaces = 1;
+    frame.target_interface_id[0] = motor_interface::ID_TARGET_POSITION;
+    frame.position = value;
+    return frame;
+}
+
+TEST(FaultContainment, FaultsOneAxisAndResetsIt)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("fault_containment"));
+    auto& faulty = static_cast<simulation::SimulationController&>(manager.controller(0));
+    auto& healthy = static_cast<simulation::SimulationController&>(manager.controller(1));
+    const simulation::virtual_slave_t& faulty_slave = faulty.master()->slave(faulty.slave_index());
+    const simulation::virtual_slave_t& healthy_slave = healthy.master()->slave(healthy.slave_index());
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    motor_interface::motor_frame_t frames[2]{position(0.1), position(0.1)};
+    manager.write(frames, 2);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    const int64_t before = faulty_slave.target_position_value;
+    ASSERT_GT(before, 0);
+
+    faulty.master()->inject_fault(faulty.slave_index(), 0x7500);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    motor_manager::bus_health_t health = manager.health();
+    EXPECT_EQ(health.faulted_axes, 1);
+    EXPECT_EQ(health.axis_faults, 1u);
+    EXPECT_EQ(faulty_slave.state, simulation::SlaveState::Fault);
+
+    // The healthy axis keeps following new targets; the faulted one holds the last command in its image.
+    frames[0] = position(-0.2);
+    frames[1] = position(-0.2);
+    manager.write(frames, 2);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_LT(healthy_slave.target_position_value, 0);
+    EXPECT_EQ(healthy_slave.state, simulation::SlaveState::OperationEnabled);
+    EXPECT_EQ(faulty_slave.target_position_value, before);
+
+    // reset_fault() walks the axis back to operation enabled; the command written meanwhile then goes out.
+    ASSERT_TRUE(manager.reset_fault(0));
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    health = manager.health();
+    EXPECT_EQ(health.faulted_axes, 0);
+    EXPECT_EQ(health.fault_resets, 1u);
+    EXPECT_EQ(faulty_slave.state, simulation::SlaveState::OperationEnabled);
+    EXPECT_LT(faulty_slave.target_position_value, 0);
+    for (int k = 0; k < 100; ++k) manager.step(time += PERIOD);
+    EXPECT_NEAR(faulty_slave.position, healthy_slave.position, std::abs(healthy_slave.position) * 0.01);
+
+    EXPECT_FALSE(manager.reset_fault(2));
+}
+
+} // namespace
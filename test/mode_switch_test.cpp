@@ -0,0 +1,125 @@
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+using motor_interface::OperationMode;
+
+constexpr int8_t CSP = static_cast<int8_t>(OperationMode::CyclicSyncPosition);
+constexpr int8_t CST = static_cast<int8_t>(OperationMode::CyclicSyncTorque);
+
+/** Signed little-endian value of `slot` in the process image, as the manager last wrote it. */
+int64_t imageValue(simulation::SimulationController& controller, const simulation::pdo_slot_t& slot)
+{
+    uint64_t raw{0};
+    std::memcpy(&raw, controller.master()->process_data() + slot.offset, slot.size);
+    const unsigned shift = 64u - 8u * slot.size;
+    return static_cast<int64_t>(raw << shift) >> shift;
+}
+
+motor_interface::motor_frame_t command(uint8_t id, double value)
+{
+    motor_interface::motor_frame_t frame{};
+    frame.number_of_target_interfaces = 1;
+    frame.target_interface_id[0] = id;
+    frame.position = value;
+    frame.torque = value;
+    return frame;
+}
+
+TEST(ModeSwitch, CspToCstAndBackIsBumpless)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("mode_switch"));
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+    const simulation::virtual_slave_t& slave = controller.master()->slave(controller.slave_index());
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    // Leave the axis part-way to its CSP target, so a stale target would show as a jump.
+    const motor_manager::axis_command_t move{0, command(motor_interface::ID_TARGET_POSITION, 0.5)};
+    manager.write(&move, 1);
+    for (int k = 0; k < 4; ++k) manager.step(time += PERIOD);
+
+    ASSERT_TRUE(manager.set_mode(0, OperationMode::CyclicSyncTorque));
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    int8_t mode{0};
+    ASSERT_TRUE(manager.mode(0, mode));
+    EXPECT_EQ(mode, CST);
+    EXPECT_EQ(slave.mode, CST);
+    EXPECT_EQ(slave.target_torque_value, std::llround(slave.torque));
+    EXPECT_EQ(manager.health().mode_switches, 1u);
+
+    // CST holds the position without a load model; back in CSP the target starts there, not at the old 0.5 rad.
+    const double held = slave.position;
+    ASSERT_GT(held, 0.0);
+    ASSERT_TRUE(manager.set_mode(0, OperationMode::CyclicSyncPosition));
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    ASSERT_TRUE(manager.mode(0, mode));
+    EXPECT_EQ(mode, CSP);
+    EXPECT_LE(std::llabs(slave.target_position_value - std::llround(held)), 1);
+    EXPECT_NEAR(slave.position, held, 1.0);
+    EXPECT_EQ(manager.health().mode_switches, 2u);
+    EXPECT_EQ(manager.health().mode_timeouts, 0u);
+
+    EXPECT_FALSE(manager.mode(2, mode));
+    EXPECT_FALSE(manager.set_mode(2, OperationMode::CyclicSyncTorque));
+}
+
+TEST(ModeSwitch, HoldsUntilDisplayedAndTimesOut)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("mode_switch_timeout"));
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+    simulation::SimulationMaster& master = *controller.master();
+    const simulation::virtual_slave_t& slave = master.slave(controller.slave_index());
+
+    // A replayed drive, enabled in CSP, displays whatever mode the test scripts (`start()` clears replay).
+    manager.start();
+    simulation::replay_status_t status{0x0027, 0, 0, 0, 0, CSP};
+    master.replay(controller.slave_index(), status);
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    ASSERT_TRUE(manager.set_mode(0, OperationMode::CyclicSyncTorque));
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(imageValue(controller, slave.mode_of_operation), CST);
+
+    // Switching: commands wait until the drive displays the mode.
+    const motor_manager::axis_command_t torque{0, command(motor_interface::ID_TARGET_TORQUE, 0.5)};
+    manager.write(&torque, 1);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(imageValue(controller, slave.target_torque), 0);
+    EXPECT_EQ(manager.health().mode_switches, 0u);
+
+    status.mode_display = CST;
+    master.replay(controller.slave_index(), status);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_NE(imageValue(controller, slave.target_torque), 0);
+    EXPECT_EQ(manager.health().mode_switches, 1u);
+
+    // A drive that keeps CST: after MODE_SWITCH_TIMEOUT cycles the axis adopts it and writes it back.
+    ASSERT_TRUE(manager.set_mode(0, OperationMode::CyclicSyncPosition));
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    EXPECT_EQ(imageValue(controller, slave.mode_of_operation), CSP);
+    for (uint32_t k = 0; k < motor_manager::MODE_SWITCH_TIMEOUT; ++k) manager.step(time += PERIOD);
+    const motor_manager::bus_health_t health = manager.health();
+    EXPECT_EQ(health.mode_timeouts, 1u);
+    EXPECT_EQ(health.mode_switches, 1u);
+    EXPECT_EQ(health.faulted_axes, 0);
+    EXPECT_EQ(imageValue(controller, slave.mode_of_operation), CST);
+    int8_t mode{0};
+    ASSERT_TRUE(manager.mode(0, mode));
+    EXPECT_EQ(mode, CST);
+}
+
+} // namespace
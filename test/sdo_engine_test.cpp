@@ -0,0 +1,213 @@
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "motor_manager/sdo_engine.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+using motor_interface::sdo_request_t;
+using motor_manager::sdo_result_t;
+
+/** SDO channel stand-in: a transfer stays busy for `latency` polls, or while `stuck`; logs the requests it starts. */
+class FakeController : public motor_interface::MotorController {
+public:
+    explicit FakeController(uint16_t index)
+    : motor_interface::MotorController(motor_interface::slave_config_t{index, 0, 0}) {}
+
+    void initialize(motor_interface::MotorMaster&, motor_interface::MotorDriver&) override {}
+    bool enable() override { return true; }
+    bool disable() override { return true; }
+    void check(const motor_interface::motor_frame_t&) override {}
+    void write(const motor_interface::motor_frame_t&) override {}
+    void read(motor_interface::motor_frame_t&) override {}
+
+    bool startSdo(const sdo_request_t& request) override
+    {
+        calls++;
+        if (busy) return false;
+        busy = true;
+        polls = latency;
+        started.push_back(request);
+        return true;
+    }
+
+    motor_interface::SdoState pollSdo(uint32_t& value) override
+    {
+        calls++;
+        if (!busy) return motor_interface::SdoState::Failed;
+        if (stuck || polls-- > 0) return motor_interface::SdoState::Busy;
+        busy = false;
+        value = started.back().value + 1;
+        return motor_interface::SdoState::Done;
+    }
+
+    uint8_t latency{0};
+    bool stuck{false};
+    bool busy{false};
+    uint8_t polls{0};
+    uint32_t calls{0};
+    std::vector<sdo_request_t> started;
+
+protected:
+    void registerEntries() override {}
+    void writeData(const int32_t*, uint16_t) override {}
+    void readData(int32_t*) override {}
+};
+
+struct Channels {
+    explicit Channels(uint16_t n)
+    {
+        for (uint16_t i = 0; i < n; ++i) controllers.push_back(std::make_unique<FakeController>(i));
+        engine.resize(n);
+    }
+
+    FakeController& at(uint16_t i) { return static_cast<FakeController&>(*controllers[i]); }
+
+    /** One RT cycle; returns the controller calls it made. */
+    uint32_t process()
+    {
+        uint32_t before{0};
+        for (uint16_t i = 0; i < controllers.size(); ++i) before += at(i).calls;
+        engine.process(controllers.data(), static_cast<uint16_t>(controllers.size()));
+        uint32_t after{0};
+        for (uint16_t i = 0; i < controllers.size(); ++i) after += at(i).calls;
+        return after - before;
+    }
+
+    std::vector<std::unique_ptr<motor_interface::MotorController>> controllers;
+    motor_manager::SdoEngine engine;
+};
+
+sdo_request_t write(uint32_t value)
+{
+    return sdo_request_t{0x2000, 0, 4, true, value};
+}
+
+bool ready(const std::future<sdo_result_t>& future)
+{
+    return future.wait_for(std::chrono::seconds(1)) == std::future_status::ready;
+}
+
+TEST(SdoEngine, ReadAndWriteCompleteOnSimulatedSlave)
+{
+    motor_manager::MotorManager manager(test::writeConfiguration("sdo_engine"));
+    manager.start();
+    uint64_t time = 1000000000;
+    const auto await = [&](std::future<sdo_result_t>& future) {
+        for (int k = 0; k < 100 && future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready; ++k) {
+            manager.step(time += PERIOD);
+        }
+        return future.get();
+    };
+
+    std::future<sdo_result_t> written = manager.write_sdo(1, 0x6072, 0, 2, 1234);
+    EXPECT_EQ(await(written).error, 0);
+    std::future<sdo_result_t> read = manager.read_sdo(1, 0x6072, 0);
+    const sdo_result_t result = await(read);
+    EXPECT_EQ(result.error, 0);
+    EXPECT_EQ(result.value, 1234u);
+
+    std::future<sdo_result_t> missing = manager.read_sdo(1, 0x2FFF, 0);
+    EXPECT_EQ(await(missing).error, -EIO);
+    manager.stop();
+}
+
+TEST(SdoEngine, RejectsFullPoolAndInvalidRequests)
+{
+    Channels channels(2);
+    std::vector<std::future<sdo_result_t>> queued;
+    for (uint8_t k = 0; k < motor_manager::SDO_POOL_SIZE; ++k) queued.push_back(channels.engine.submit(0, write(k)));
+
+    std::future<sdo_result_t> full = channels.engine.submit(1, write(0));
+    ASSERT_TRUE(ready(full));
+    EXPECT_EQ(full.get().error, -EAGAIN);
+    EXPECT_FALSE(channels.engine.submit(1, write(0), [](const sdo_result_t&) {}));
+
+    channels.engine.cancel();
+    for (auto& future : queued) {
+        ASSERT_TRUE(ready(future));
+        EXPECT_EQ(future.get().error, -ECANCELED);
+    }
+
+    std::future<sdo_result_t> size = channels.engine.submit(0, sdo_request_t{0x2000, 0, 3, true, 0});
+    ASSERT_TRUE(ready(size));
+    EXPECT_EQ(size.get().error, -EINVAL);
+    EXPECT_FALSE(channels.engine.submit(0, sdo_request_t{0x2000, 0, 3, true, 0}, [](const sdo_result_t&) {}));
+
+    std::future<sdo_result_t> index = channels.engine.submit(2, write(0));
+    channels.process();
+    ASSERT_TRUE(ready(index));
+    EXPECT_EQ(index.get().error, -EINVAL);
+    EXPECT_TRUE(channels.at(0).started.empty());
+}
+
+TEST(SdoEngine, KeepsFifoOrderPerAxisWithinBudget)
+{
+    Channels channels(3);
+    for (uint16_t i = 0; i < 3; ++i) channels.at(i).latency = 2;
+
+    constexpr uint32_t PER_AXIS = 6;
+    std::vector<std::future<sdo_result_t>> futures[3];
+    for (uint32_t k = 0; k < PER_AXIS; ++k) {
+        for (uint16_t i = 0; i < 3; ++i) futures[i].push_back(channels.engine.submit(i, write(100 * i + k)));
+    }
+
+    for (int cycle = 0; cycle < 200; ++cycle) EXPECT_LE(channels.process(), motor_manager::SDO_BUDGET);
+
+    for (uint16_t i = 0; i < 3; ++i) {
+        const std::vector<sdo_request_t>& started = channels.at(i).started;
+        ASSERT_EQ(started.size(), PER_AXIS) << "axis " << i;
+        for (uint32_t k = 0; k < PER_AXIS; ++k) {
+            EXPECT_EQ(started[k].value, 100 * i + k) << "axis " << i;
+            ASSERT_TRUE(ready(futures[i][k]));
+            const sdo_result_t result = futures[i][k].get();
+            EXPECT_EQ(result.error, 0);
+            EXPECT_EQ(result.value, 100 * i + k + 1);
+        }
+    }
+}
+
+TEST(SdoEngine, CancelsAndReusesOrphanedChannel)
+{
+    Channels channels(1);
+    channels.at(0).stuck = true;
+
+    std::future<sdo_result_t> in_flight = channels.engine.submit(0, write(1));
+    channels.process();
+    ASSERT_EQ(channels.at(0).started.size(), 1u);
+    std::future<sdo_result_t> waiting = channels.engine.submit(0, write(2));
+    channels.process();
+
+    // As after `run()` returns: both fail, the channel stays busy with the cancelled transfer.
+    channels.engine.cancel();
+    ASSERT_TRUE(ready(in_flight));
+    EXPECT_EQ(in_flight.get().error, -ECANCELED);
+    ASSERT_TRUE(ready(waiting));
+    EXPECT_EQ(waiting.get().error, -ECANCELED);
+
+    // The next transfer waits for the orphan to finish, which is polled and dropped; then it runs normally.
+    std::future<sdo_result_t> next = channels.engine.submit(0, write(3));
+    for (int k = 0; k < 5; ++k) channels.process();
+    EXPECT_EQ(channels.at(0).started.size(), 1u);
+    channels.at(0).stuck = false;
+    for (int k = 0; k < 5; ++k) channels.process();
+    ASSERT_EQ(channels.at(0).started.size(), 2u);
+    EXPECT_EQ(channels.at(0).started.back().value, 3u);
+    ASSERT_TRUE(ready(next));
+    const sdo_result_t result = next.get();
+    EXPECT_EQ(result.error, 0);
+    EXPECT_EQ(result.value, 4u);
+}
+
+} // namespace
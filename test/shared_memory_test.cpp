@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "motor_manager/shared_memory.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+TEST(SharedMemory, WriteAfterSharedMemoryCommandIsNotDropped)
+{
+    const std::string name = "/motor_manager_test_" + std::to_string(getpid());
+    motor_manager::MotorManager manager(test::writeConfiguration("shared_memory"));
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+    const auto target = [&] { return controller.master()->slave(controller.slave_index()).target_position_value; };
+    manager.open_shared_memory(name);
+    motor_manager::SharedMemoryClient client;
+    client.open(name);
+
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+
+    motor_interface::motor_frame_t a[2]{};
+    for (auto& frame : a) {
+        frame.number_of_target_interfaces = 1;
+        frame.target_interface_id[0] = motor_interface::ID_TARGET_POSITION;
+        frame.position = 0.5;
+    }
+    motor_interface::motor_frame_t b = a[0];
+    b.position = -0.5;
+
+    // write(A), shared-memory B, write(A) again: the last one must reach the image although `write()` saw A before.
+    manager.write(a, 2);
+    for (int k = 0; k < 2; ++k) manager.step(time += PERIOD);
+    EXPECT_GT(target(), 0);
+    ASSERT_TRUE(client.write(0, b));
+    for (int k = 0; k < 2; ++k) manager.step(time += PERIOD);
+    EXPECT_LT(target(), 0);
+    manager.write(a, 2);
+    for (int k = 0; k < 2; ++k) manager.step(time += PERIOD);
+    EXPECT_GT(target(), 0);
+
+    // Unchanged commands are still deduplicated once the writer owns the axis again.
+    manager.write(a, 2);
+    for (int k = 0; k < 2; ++k) manager.step(time += PERIOD);
+    EXPECT_GT(target(), 0);
+
+    client.close();
+    manager.close_shared_memory();
+}
+
+} // namespace
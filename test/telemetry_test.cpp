@@ -0,0 +1,53 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/motor_manager.hpp"
+#include "motor_manager/telemetry.hpp"
+#include "simulation/simulation_controller.hpp"
+#include "test_configuration.hpp"
+
+namespace {
+
+constexpr uint64_t PERIOD = 1000000;
+
+TEST(Telemetry, RecordsControlwordWrittenToProcessImage)
+{
+    const std::string config = test::writeConfiguration("telemetry");
+    const std::string path = (std::filesystem::path(config).parent_path() / "log.bin").string();
+
+    // The client never writes a command: every controlword comes from the enable walk and the fault reset.
+    motor_manager::MotorManager manager(config);
+    auto& controller = static_cast<simulation::SimulationController&>(manager.controller(0));
+    manager.start_recording(path);
+    manager.start();
+    uint64_t time = 1000000000;
+    for (int k = 0; k < 10; ++k) manager.step(time += PERIOD);
+    controller.master()->inject_fault(controller.slave_index(), 0x7500);
+    for (int k = 0; k < 5; ++k) manager.step(time += PERIOD);
+    manager.reset_fault(0);
+    for (int k = 0; k < 20; ++k) manager.step(time += PERIOD);
+    manager.stop_recording();
+
+    motor_manager::TelemetryLog log;
+    log.open(path);
+    std::vector<uint16_t> controlwords;
+    for (std::size_t k = 0; k < log.size(); ++k) {
+        if (log.samples()[k].axis == 0) controlwords.push_back(log.samples()[k].controlword);
+    }
+    ASSERT_EQ(controlwords.size(), 35u);
+
+    const std::vector<uint16_t> enable{0x0006, 0x0007, 0x000F};
+    EXPECT_TRUE(std::equal(enable.begin(), enable.end(), controlwords.begin()));
+
+    // reset: a cleared controlword, the fault reset edge, then the enable walk again
+    const std::vector<uint16_t> reset{0x0000, 0x0080, 0x0006, 0x0007, 0x000F};
+    EXPECT_NE(std::search(controlwords.begin() + 3, controlwords.end(), reset.begin(), reset.end()), controlwords.end());
+    EXPECT_EQ(controlwords.back(), controller.controlword());
+}
+
+} // namespace
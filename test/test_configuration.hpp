@@ -0,0 +1,59 @@
+#ifndef MOTOR_MANAGER_TEST_CONFIGURATION_HPP_
+#define MOTOR_MANAGER_TEST_CONFIGURATION_HPP_
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace test {
+
+/** MINAS parameter file of the test drives: CSP mapping plus modes of operation and its display. */
+constexpr char MINAS_PARAMETERS[] =
+    "items:\n"
+    "  - {id: 50, index: 0x6072, subindex: 0, type: u16}\n"
+    "  - {id: 10, index: 0x6060, subindex: 0, type: s8, value: 8}\n"
+    "interfaces:\n"
+    "  - {id: 98, index: 0x1600}\n"
+    "  - {id: 0, index: 0x6040, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 1, index: 0x607A, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 2, index: 0x60FF, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 3, index: 0x6071, subindex: 0, size: 2, type: s16}\n"
+    "  - {id: 9, index: 0x6060, subindex: 0, size: 1, type: s8}\n"
+    "  - {id: 99, index: 0x1A00}\n"
+    "  - {id: 4, index: 0x6041, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 5, index: 0x603F, subindex: 0, size: 2, type: u16}\n"
+    "  - {id: 6, index: 0x6064, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 7, index: 0x606C, subindex: 0, size: 4, type: s32}\n"
+    "  - {id: 8, index: 0x6077, subindex: 0, size: 2, type: s16}\n"
+    "  - {id: 10, index: 0x6061, subindex: 0, size: 1, type: s8}\n";
+
+/**
+ * Writes a one-master simulation configuration of `axes` MINAS axes into a fresh temp directory and returns its
+ * path. `top` is appended at the top level and `master` inside the master block (indented by four spaces).
+ */
+inline std::string writeConfiguration(const std::string& name, const std::string& top = "", const std::string& master = "", uint16_t axes = 2)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "motor_manager_tests" / name;
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    std::ofstream(directory / "minas.yaml") << MINAS_PARAMETERS;
+
+    std::ofstream out(directory / "config.yaml");
+    out << "period: 1000000\n" << top << "masters:\n"
+           "  - id: 0\n"
+           "    type: simulation\n"
+           "    number_of_slaves: " << axes << "\n"
+           "    time_constant: 0.005\n" << master <<
+           "    slaves:\n";
+    for (uint16_t i = 0; i < axes; ++i) out << "      - {controller_index: " << i << ", driver_id: 0}\n";
+    out << "drivers:\n"
+           "  - {id: 0, type: minas, param_file: minas.yaml, pulse_per_revolution: 8388608, rated_torque: 1.27, "
+           "unit_torque: 1.0, lower: -3.14, upper: 3.14, speed: 3000, acceleration: 100, deceleration: 100, "
+           "profile_velocity: 1, profile_acceleration: 1, profile_deceleration: 1}\n";
+    return (directory / "config.yaml").string();
+}
+
+} // namespace test
+#endif // MOTOR_MANAGER_TEST_CONFIGURATION_HPP_
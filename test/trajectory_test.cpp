@@ -0,0 +1,164 @@
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include "motor_manager/trajectory.hpp"
+
+namespace {
+
+using motor_manager::Interpolation;
+using motor_manager::TrajectoryFollower;
+using motor_manager::waypoint_t;
+
+constexpr uint64_t SECOND = 1000000000;
+
+constexpr double TOLERANCE = 1e-6;
+
+struct set_point_t {
+    double position;
+
+    double velocity;
+
+    double acceleration;
+};
+
+set_point_t sample(TrajectoryFollower& follower, uint64_t time)
+{
+    set_point_t p{};
+    EXPECT_TRUE(follower.sample(time, 0.0, p.position, p.velocity, p.acceleration));
+    return p;
+}
+
+/**
+ * Queues `a` then `b` (segment a -> b shaped by `interpolation`) and samples the second segment at s = 0 (exactly at
+ * `a.time`) and s = 1 (one nanosecond before `b.time`, when the follower would move past it).
+ */
+void boundaries(Interpolation interpolation, set_point_t& begin, set_point_t& end)
+{
+    TrajectoryFollower follower;
+    ASSERT_TRUE(follower.push({1 * SECOND, 1.0, 2.0, 3.0, interpolation}));
+    ASSERT_TRUE(follower.push({3 * SECOND, 4.0, -1.0, 0.5, interpolation}));
+    sample(follower, 0);
+    begin = sample(follower, 1 * SECOND);
+    end = sample(follower, 3 * SECOND - 1);
+}
+
+TEST(Trajectory, LinearBoundaries)
+{
+    set_point_t begin, end;
+    boundaries(Interpolation::Linear, begin, end);
+
+    EXPECT_NEAR(begin.position, 1.0, TOLERANCE);
+    EXPECT_NEAR(begin.velocity, 1.5, TOLERANCE);
+    EXPECT_NEAR(begin.acceleration, 0.0, TOLERANCE);
+    EXPECT_NEAR(end.position, 4.0, TOLERANCE);
+    EXPECT_NEAR(end.velocity, 1.5, TOLERANCE);
+    EXPECT_NEAR(end.acceleration, 0.0, TOLERANCE);
+}
+
+TEST(Trajectory, CubicBoundaries)
+{
+    set_point_t begin, end;
+    boundaries(Interpolation::Cubic, begin, end);
+
+    // Hermite end accelerations: (6 delta - 4 v0 T - 2 v1 T) / T^2 and (-6 delta + 2 v0 T + 4 v1 T) / T^2
+    EXPECT_NEAR(begin.position, 1.0, TOLERANCE);
+    EXPECT_NEAR(begin.velocity, 2.0, TOLERANCE);
+    EXPECT_NEAR(begin.acceleration, (18.0 - 16.0 + 4.0) / 4.0, TOLERANCE);
+    EXPECT_NEAR(end.position, 4.0, TOLERANCE);
+    EXPECT_NEAR(end.velocity, -1.0, TOLERANCE);
+    EXPECT_NEAR(end.acceleration, (-18.0 + 8.0 - 8.0) / 4.0, TOLERANCE);
+}
+
+TEST(Trajectory, QuinticBoundaries)
+{
+    set_point_t begin, end;
+    boundaries(Interpolation::Quintic, begin, end);
+
+    EXPECT_NEAR(begin.position, 1.0, TOLERANCE);
+    EXPECT_NEAR(begin.velocity, 2.0, TOLERANCE);
+    EXPECT_NEAR(begin.acceleration, 3.0, TOLERANCE);
+    EXPECT_NEAR(end.position, 4.0, TOLERANCE);
+    EXPECT_NEAR(end.velocity, -1.0, TOLERANCE);
+    EXPECT_NEAR(end.acceleration, 0.5, TOLERANCE);
+}
+
+TEST(Trajectory, StartsFromMeasuredPosition)
+{
+    TrajectoryFollower follower;
+    ASSERT_TRUE(follower.push({SECOND, 1.0, 0.0, 0.0, Interpolation::Quintic}));
+
+    double position, velocity, acceleration;
+    ASSERT_TRUE(follower.sample(0, 0.25, position, velocity, acceleration));
+    EXPECT_NEAR(position, 0.25, TOLERANCE);
+    EXPECT_NEAR(velocity, 0.0, TOLERANCE);
+    EXPECT_NEAR(acceleration, 0.0, TOLERANCE);
+}
+
+TEST(Trajectory, HoldsLastWaypointWhenQueueRunsDry)
+{
+    TrajectoryFollower follower;
+    ASSERT_TRUE(follower.push({SECOND, 2.0, 0.5, 0.0, Interpolation::Cubic}));
+    sample(follower, 0);
+    EXPECT_TRUE(follower.active());
+
+    const set_point_t held = sample(follower, SECOND + 10);
+    EXPECT_DOUBLE_EQ(held.position, 2.0);
+    EXPECT_DOUBLE_EQ(held.velocity, 0.0);
+    EXPECT_DOUBLE_EQ(held.acceleration, 0.0);
+    EXPECT_FALSE(follower.active());
+
+    // inactive: the caller keeps the last set-point in the image
+    double position, velocity;
+    EXPECT_FALSE(follower.sample(2 * SECOND, 2.0, position, velocity));
+
+    // A late chunk continues from the held set-point, not the measured position passed as `start`, and reaches its
+    // waypoint on time.
+    ASSERT_TRUE(follower.push({4 * SECOND, 3.0, 0.0, 0.0, Interpolation::Linear}));
+    set_point_t resumed{};
+    ASSERT_TRUE(follower.sample(3 * SECOND, 0.0, resumed.position, resumed.velocity, resumed.acceleration));
+    EXPECT_DOUBLE_EQ(resumed.position, 2.0);
+    EXPECT_TRUE(follower.active());
+    ASSERT_TRUE(follower.sample(3 * SECOND + SECOND / 2, 0.0, resumed.position, resumed.velocity, resumed.acceleration));
+    EXPECT_NEAR(resumed.position, 2.5, TOLERANCE);
+    EXPECT_NEAR(resumed.velocity, 1.0, TOLERANCE);
+
+    // Once released (another command took over the image) or aborted, a trajectory starts from `start` again.
+    const set_point_t end = sample(follower, 4 * SECOND);
+    EXPECT_DOUBLE_EQ(end.position, 3.0);
+    follower.release();
+    ASSERT_TRUE(follower.push({6 * SECOND, 1.0, 0.0, 0.0, Interpolation::Linear}));
+    ASSERT_TRUE(follower.sample(5 * SECOND, 0.5, resumed.position, resumed.velocity));
+    EXPECT_DOUBLE_EQ(resumed.position, 0.5);
+
+    follower.abort();
+    ASSERT_TRUE(follower.push({8 * SECOND, 1.0, 0.0, 0.0, Interpolation::Linear}));
+    ASSERT_TRUE(follower.sample(7 * SECOND, -0.5, resumed.position, resumed.velocity));
+    EXPECT_DOUBLE_EQ(resumed.position, -0.5);
+}
+
+TEST(Trajectory, CollapsesOutOfOrderWaypoint)
+{
+    TrajectoryFollower follower;
+    ASSERT_TRUE(follower.push({2 * SECOND, 1.0, 0.0, 0.0, Interpolation::Linear}));
+    ASSERT_TRUE(follower.push({1 * SECOND, 5.0, 0.0, 0.0, Interpolation::Linear}));  // earlier than the one before
+    ASSERT_TRUE(follower.push({4 * SECOND, 7.0, 0.0, 0.0, Interpolation::Linear}));
+    sample(follower, 0);
+
+    // reaching 2 s also consumes the stale waypoint: the next segment runs from it (5 @ 1 s) to 7 @ 4 s
+    const set_point_t p = sample(follower, 2 * SECOND);
+    EXPECT_NEAR(p.position, 5.0 + 2.0 / 3.0, TOLERANCE);
+    EXPECT_NEAR(p.velocity, 2.0 / 3.0, TOLERANCE);
+
+    // a stale waypoint at the end of the queue is held at once
+    TrajectoryFollower tail;
+    ASSERT_TRUE(tail.push({2 * SECOND, 1.0, 0.0, 0.0, Interpolation::Linear}));
+    ASSERT_TRUE(tail.push({1 * SECOND, 5.0, 0.0, 0.0, Interpolation::Linear}));
+    sample(tail, 0);
+    const set_point_t held = sample(tail, 2 * SECOND);
+    EXPECT_DOUBLE_EQ(held.position, 5.0);
+    EXPECT_DOUBLE_EQ(held.velocity, 0.0);
+    EXPECT_FALSE(tail.active());
+}
+
+} // namespace